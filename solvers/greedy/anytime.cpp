@@ -0,0 +1,157 @@
+/**
+ * @file
+ * @brief Anytime solver with a time limit.
+ * Usage:
+ *     anytime [--time-limit S] [--checkpoint S] [--seed N] input.in output.out
+ * Writes an empty solution first. The input is read and the conflict aware greedy1 and greedy2
+ * solutions are constructed on separate threads, which publish them through an Incumbent. The
+ * first one to finish is improved with local search until `--time-limit` seconds (default 60)
+ * have passed since start, and the other is taken over if it finishes with a better score. At
+ * local optima a random cache is emptied and the search continues from there. The best solution
+ * so far is written to the output through a temporary file every `--checkpoint` seconds
+ * (default 5), on SIGTERM or SIGINT and at the end, so the output file always holds a complete
+ * valid solution, even if the time runs out while reading or constructing.
+ */
+
+#include <csignal>
+#include <iostream>
+#include <vector>
+#include "includes.hpp"
+#include "common.hpp"
+#include "instance.hpp"
+#include "greedy.hpp"
+#include "decompose.hpp"
+#include "driver.hpp"
+#include "local_search.hpp"
+#include "incumbent.hpp"
+#include "score.hpp"
+
+using namespace mm;
+using namespace std;
+
+volatile sig_atomic_t terminate_requested = 0;
+
+void on_terminate(int) { terminate_requested = 1; }
+
+double seconds_since(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/// Instance and best solution shared with the threads reading and constructing.
+struct Shared {
+    ifstream in;
+    Instance inst;  ///< valid once `loaded` is set
+    Incumbent incumbent;
+    atomic<bool> loaded;
+    atomic<int> running;  ///< threads not finished yet
+    Shared() : loaded(false), running(0) {}
+};
+
+/// Runs `solver` on all components of the instance and offers the result.
+void construct(std::shared_ptr<Shared> shared, const string& name, solver_t solver) {
+    const Instance& inst = shared->inst;
+    vector<vector<int>> result = solve_by_components(inst, solver);
+    // one write, so it does not split lines of the main thread
+    cerr << name + ": " + to_string(score(inst, result)) + "\n";
+    shared->incumbent.offer(saved_latency(inst, result), result);
+    --shared->running;
+}
+
+int main(int argc, char* argv[]) {
+    Options opt(argc, argv);
+    if (opt.positional.size() != 2) {
+        cerr << "Usage: " << argv[0] << " [--time-limit S] [--checkpoint S] [--seed N] "
+             << "input.in output.out" << endl;
+        return 1;
+    }
+    auto start = chrono::steady_clock::now();
+    double time_limit = opt.get_double("time-limit", 60);
+    double interval = opt.get_double("checkpoint", 5);
+    // leave time for the last write
+    double deadline = time_limit - min(1.0, 0.05 * time_limit);
+    string output = opt.positional[1];
+    signal(SIGTERM, on_terminate);
+    signal(SIGINT, on_terminate);
+
+    std::shared_ptr<Shared> shared = make_shared<Shared>();
+    shared->in.open(opt.positional[0]);
+    if (!shared->in) {
+        cerr << "Cannot open " << opt.positional[0] << endl;
+        return 1;
+    }
+    const Instance& inst = shared->inst;
+    Incumbent& incumbent = shared->incumbent;
+    double last_write = seconds_since(start);
+    auto checkpoint = [&]() {
+        // no caches are known before the instance is read, no caches is a valid solution too
+        if (!incumbent.write(output, shared->loaded ? inst.C : 0))
+            cerr << "Cannot write " << output << endl;
+        last_write = seconds_since(start);
+        // once the other threads are done, this one is the only user of the store
+        if (shared->running == 0) incumbent.reclaim();
+    };
+    checkpoint();
+
+    // reading and construction cannot be interrupted, so they run on threads of their own
+    shared->running = 3;
+    thread([shared]() {
+        shared->inst = read_instance(shared->in);
+        shared->loaded = true;
+        thread(construct, shared, "greedy1-conflict", solver_by_name("greedy1-conflict"))
+                .detach();
+        thread(construct, shared, "greedy2", solver_by_name("greedy2")).detach();
+        --shared->running;
+    }).detach();
+
+    while (!terminate_requested && seconds_since(start) < deadline && !incumbent.best()) {
+        this_thread::sleep_for(chrono::milliseconds(10));
+        if (seconds_since(start) - last_write >= interval) checkpoint();
+    }
+    if (!incumbent.best()) {
+        checkpoint();
+        cerr << "No solution constructed after " << seconds_since(start) << " s, wrote an "
+             << "empty one" << endl;
+        _Exit(0);
+    }
+    Placement best(inst, incumbent.best()->videos_per_cache);
+    cerr << "starting local search from " << best.score() << " after " << seconds_since(start)
+         << " s" << endl;
+    checkpoint();
+
+    mt19937 rng(opt.seed());
+    Placement current = best;
+    auto pause = [&]() {
+        return terminate_requested || seconds_since(start) >= deadline ||
+               seconds_since(start) - last_write >= interval ||
+               incumbent.best_saved() > best.saved();
+    };
+    while (!terminate_requested && seconds_since(start) < deadline) {
+        if (incumbent.best_saved() > best.saved()) {
+            // another thread found something better, continue from it
+            current = best = Placement(inst, incumbent.best()->videos_per_cache);
+            cerr << "adopted " << best.score() << " after " << seconds_since(start) << " s"
+                 << endl;
+        }
+        int64_t before = current.saved();
+        local_search(current, pause);
+        bool optimum = !pause();
+        if (current.saved() > best.saved()) {
+            best = current;
+            incumbent.offer(best.saved(), best.videos_per_cache());
+            cerr << "local search: " << best.score() << " after " << seconds_since(start)
+                 << " s" << endl;
+        }
+        if (seconds_since(start) - last_write >= interval) checkpoint();
+        if (optimum || current.saved() == before) {
+            // restart from the best solution with one random cache emptied
+            current = best;
+            if (inst.C > 0) current.clear(uniform_int_distribution<int>(0, inst.C - 1)(rng));
+        }
+    }
+    checkpoint();
+    cerr << "Best score " << score(inst, incumbent.best()->videos_per_cache) << " written after "
+         << seconds_since(start) << " s" << endl;
+    // constructions cannot be interrupted, do not wait for them
+    if (shared->running > 0) _Exit(0);
+    return 0;
+}
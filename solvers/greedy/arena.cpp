@@ -0,0 +1,39 @@
+/**
+ * @file
+ * @brief Implementation of the bump allocator declared in arena.hpp.
+ */
+
+#include "arena.hpp"
+
+namespace mm {
+
+Arena::Arena(size_t initial_bytes) : cur_(nullptr), end_(nullptr), used_(0), reserved_(0) {
+    add_region(std::max<size_t>(initial_bytes, 64));
+}
+
+Arena::~Arena() {
+    for (char* region : regions_) std::free(region);
+}
+
+void Arena::add_region(size_t bytes) {
+    char* region = static_cast<char*>(std::malloc(bytes));
+    if (region == nullptr) throw std::bad_alloc();
+    regions_.push_back(region);
+    cur_ = region;
+    end_ = region + bytes;
+    reserved_ += bytes;
+}
+
+void* Arena::allocate(size_t bytes, size_t align) {
+    uintptr_t p = (reinterpret_cast<uintptr_t>(cur_) + align - 1) & ~(uintptr_t)(align - 1);
+    if (p + bytes > reinterpret_cast<uintptr_t>(end_)) {
+        // grow geometrically so that an underestimate does not degrade into many regions
+        add_region(std::max(bytes + align, reserved_));
+        p = (reinterpret_cast<uintptr_t>(cur_) + align - 1) & ~(uintptr_t)(align - 1);
+    }
+    cur_ = reinterpret_cast<char*>(p + bytes);
+    used_ += bytes;
+    return reinterpret_cast<void*>(p);
+}
+
+}  // namespace mm
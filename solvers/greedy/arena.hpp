@@ -0,0 +1,95 @@
+#ifndef SRC_ARENA_HPP_
+#define SRC_ARENA_HPP_
+
+/**
+ * @file
+ * @brief Bump allocator for per-instance and per-solve state. Everything is allocated from one
+ * region sized upfront from the instance header, individual deallocations are no-ops and the
+ * whole region is released at once when the arena is destroyed.
+ */
+
+#include "includes.hpp"
+
+namespace mm {
+
+/**
+ * Bump region allocator. If the initial region runs out, further regions are chained, so an
+ * underestimated size costs an extra allocation, not correctness. Not thread safe; use one
+ * arena per thread of work.
+ */
+class Arena {
+  public:
+    /// Creates arena with first region of `initial_bytes` bytes.
+    explicit Arena(size_t initial_bytes = 1 << 16);
+    ~Arena();
+    Arena(const Arena&) = delete;  ///< Disallow copying
+    Arena& operator=(const Arena&) = delete;  ///< Disallow copying
+
+    /// Returns `bytes` bytes of memory aligned to `align`.
+    void* allocate(size_t bytes, size_t align);
+    /// Number of bytes handed out so far.
+    size_t used() const { return used_; }
+    /// Number of bytes reserved from the system.
+    size_t reserved() const { return reserved_; }
+    /// Number of regions allocated from the system.
+    int regions() const { return regions_.size(); }
+
+  private:
+    void add_region(size_t bytes);
+
+    std::vector<char*> regions_;  ///< all regions, freed on destruction
+    char* cur_;  ///< first free byte in current region
+    char* end_;  ///< end of current region
+    size_t used_, reserved_;
+};
+
+/**
+ * STL allocator taking memory from an Arena. A default constructed allocator has no arena and
+ * falls back to the global heap, so arena backed containers can also be used standalone.
+ */
+template <typename T>
+class ArenaAllocator {
+  public:
+    typedef T value_type;  ///< Type of allocated objects
+    typedef std::true_type propagate_on_container_move_assignment;  ///< Moves steal storage
+    typedef std::true_type propagate_on_container_swap;  ///< Swaps exchange storage
+
+    /// Heap backed allocator.
+    ArenaAllocator() noexcept : arena(nullptr) {}
+    /// Allocator taking memory from `arena_`, heap if null.
+    explicit ArenaAllocator(Arena* arena_) noexcept : arena(arena_) {}
+    /// Rebind copy constructor
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena(other.arena) {}
+
+    /// Allocate space for `n` objects.
+    T* allocate(size_t n) {
+        if (arena == nullptr) return static_cast<T*>(::operator new(n * sizeof(T)));
+        return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+    /// Return space to the heap, no-op for arena memory.
+    void deallocate(T* p, size_t) noexcept {
+        if (arena == nullptr) ::operator delete(p);
+    }
+
+    Arena* arena;  ///< arena memory is taken from, null for heap
+};
+
+/// Allocators are equal if they take memory from the same place.
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+    return a.arena == b.arena;
+}
+/// Allocators are equal if they take memory from the same place.
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+    return a.arena != b.arena;
+}
+
+/// Vector with arena backed storage.
+template <typename T>
+using avector = std::vector<T, ArenaAllocator<T>>;
+
+}  // namespace mm
+
+#endif  // SRC_ARENA_HPP_
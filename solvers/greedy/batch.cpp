@@ -0,0 +1,121 @@
+/**
+ * @file
+ * @brief Solves many instances concurrently in one process.
+ * Usage:
+ *     batch [-s solver] input1.in output1.out [input2.in output2.out ...]
+ *     batch [-s solver] -f jobs.txt
+ * where solver is one of greedy1, greedy1-conflict or greedy2 (default) and every line of
+ * jobs.txt holds an input and an output path. Instances are spread over OMP_NUM_THREADS
+ * threads, largest first, and each one is loaded into and solved in its own arena.
+ * Per-instance timings and scores are printed as a table when all are done.
+ */
+
+#include <iostream>
+#include <vector>
+#include "includes.hpp"
+#include "common.hpp"
+#include "instance.hpp"
+#include "greedy.hpp"
+#include "decompose.hpp"
+#include "score.hpp"
+
+using namespace mm;
+using namespace std;
+
+struct Job {
+    string input, output;
+    double load_time, solve_time;
+    int64_t score;
+    string error;
+};
+
+double seconds_since(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+void run(Job& job, const solver_t& solver) {
+    auto start = chrono::steady_clock::now();
+    ifstream in(job.input);
+    if (!in) {
+        job.error = "cannot open " + job.input;
+        return;
+    }
+    Instance inst = read_instance(in);
+    job.load_time = seconds_since(start);
+
+    start = chrono::steady_clock::now();
+    vector<vector<int>> videos_per_cache = solve_by_components(inst, solver);
+    job.solve_time = seconds_since(start);
+
+    ofstream out(job.output);
+    if (!out) {
+        job.error = "cannot open " + job.output;
+        return;
+    }
+    write_solution(out, videos_per_cache);
+    job.error = check_solution(inst, videos_per_cache);
+    job.score = score(inst, videos_per_cache);
+}
+
+int main(int argc, char* argv[]) {
+    string solver_name = "greedy2";
+    vector<Job> jobs;
+    vector<string> paths;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "-s" && i + 1 < argc) {
+            solver_name = argv[++i];
+        } else if (arg == "-f" && i + 1 < argc) {
+            ifstream list(argv[++i]);
+            string in, out;
+            while (list >> in >> out) {
+                paths.push_back(in);
+                paths.push_back(out);
+            }
+        } else {
+            paths.push_back(arg);
+        }
+    }
+    solver_t solver = solver_by_name(solver_name);
+    if (paths.empty() || paths.size() % 2 != 0 || !solver) {
+        cerr << "Usage: " << argv[0] << " [-s greedy1|greedy1-conflict|greedy2] "
+             << "(input output [input output ...] | -f jobs.txt)" << endl;
+        return 1;
+    }
+    for (size_t i = 0; i < paths.size(); i += 2) {
+        jobs.push_back({paths[i], paths[i + 1], 0, 0, 0, ""});
+    }
+
+    // largest inputs first, so they do not end up last on a single thread
+    vector<pair<int64_t, int>> order;
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        ifstream f(jobs[i].input, ios::binary | ios::ate);
+        order.push_back({-static_cast<int64_t>(f.tellg()), i});
+    }
+    sort(order.begin(), order.end());
+
+    auto start = chrono::steady_clock::now();
+    int n = jobs.size();
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int i = 0; i < n; ++i) {
+        Job& job = jobs[order[i].second];
+        run(job, solver);
+        #pragma omp critical
+        cerr << "Done " << job.input << " in " << job.load_time + job.solve_time << " s" << endl;
+    }
+    double total = seconds_since(start);
+
+    int64_t total_score = 0;
+    cout << "input\tload[s]\tsolve[s]\tscore" << endl;
+    for (const Job& job : jobs) {
+        cout << job.input << "\t" << job.load_time << "\t" << job.solve_time << "\t";
+        if (job.error.empty()) {
+            cout << job.score << endl;
+            total_score += job.score;
+        } else {
+            cout << "ERROR: " << job.error << endl;
+        }
+    }
+    cout << "total\t\t" << total << "\t" << total_score << endl;
+    return 0;
+}
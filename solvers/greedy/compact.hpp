@@ -0,0 +1,170 @@
+#ifndef SRC_COMPACT_HPP_
+#define SRC_COMPACT_HPP_
+
+/**
+ * @file
+ * @brief Flat, narrow-typed copy of an Instance used by solver kernels, and a dispatcher that
+ * picks the narrowest index and saving types an instance fits in. The copy and all state of the
+ * kernel run on it are allocated from one per-solve Arena.
+ */
+
+#include "instance.hpp"
+#include "memory.hpp"
+
+namespace mm {
+
+/// Number of endpoint--cache connections.
+inline size_t num_connections(const Instance& inst) {
+    size_t total = 0;
+    for (const Endpoint& ep : inst.endpoints) total += ep.num_connected_caches;
+    return total;
+}
+
+/**
+ * Instance stored in flat arrays. Ids of videos, endpoints, requests and caches are stored as
+ * `index_t`, offsets into flat arrays are always 32 bit since their count is not bounded by the
+ * header counts.
+ * @tparam index_t unsigned integer type that can hold max(V, E, R, C)
+ */
+template <typename index_t>
+struct CompactInstance {
+    typedef index_t idx_t;  ///< Type of ids
+    int V, E, R, C, X;
+    Arena* arena;  ///< arena holding this copy, kernels allocate their state from it too
+    avector<int> video_size;
+    avector<uint32_t> video_req_begin;  ///< requests of v are in [begin[v], begin[v+1])
+    avector<index_t> video_req;  ///< request ids grouped by video
+    avector<index_t> req_video, req_endpoint;
+    avector<int32_t> req_num;
+    avector<int32_t> ep_dc_lat;
+    avector<uint32_t> ep_cache_begin;  ///< caches of e are in [begin[e], begin[e+1])
+    avector<index_t> ep_cache;  ///< connected caches grouped by endpoint
+    avector<int32_t> ep_cache_lat;  ///< E x C latency table, -1 if not connected
+
+    /// Copies `inst` into flat arrays allocated from `arena_`.
+    CompactInstance(const Instance& inst, Arena* arena_)
+            : V(inst.V), E(inst.E), R(inst.R), C(inst.C), X(inst.X), arena(arena_),
+              video_size(V, 0, allocator<int>()),
+              video_req_begin(V + 1, 0, allocator<uint32_t>()),
+              video_req(allocator<index_t>()),
+              req_video(R, 0, allocator<index_t>()),
+              req_endpoint(R, 0, allocator<index_t>()),
+              req_num(R, 0, allocator<int32_t>()),
+              ep_dc_lat(E, 0, allocator<int32_t>()),
+              ep_cache_begin(E + 1, 0, allocator<uint32_t>()),
+              ep_cache(allocator<index_t>()),
+              ep_cache_lat(static_cast<size_t>(E) * C, -1, allocator<int32_t>()) {
+        for (int v = 0; v < V; ++v) {
+            video_size[v] = inst.videos[v].size;
+            video_req_begin[v + 1] = video_req_begin[v] + inst.videos[v].request_ids.size();
+        }
+        video_req.reserve(video_req_begin[V]);
+        for (int v = 0; v < V; ++v) {
+            for (int rid : inst.videos[v].request_ids) video_req.push_back(rid);
+        }
+        for (int i = 0; i < R; ++i) {
+            req_video[i] = inst.requests[i].video_id;
+            req_endpoint[i] = inst.requests[i].endpoint_id;
+            req_num[i] = inst.requests[i].num_req;
+        }
+        ep_cache.reserve(num_connections(inst));
+        for (int e = 0; e < E; ++e) {
+            const Endpoint& ep = inst.endpoints[e];
+            ep_dc_lat[e] = ep.datacenter_lat;
+            ep_cache_begin[e + 1] = ep_cache_begin[e] + ep.num_connected_caches;
+            for (int c : ep.connected_caches) {
+                ep_cache.push_back(c);
+                lat(e, c) = ep.cache_lat[c];
+            }
+        }
+    }
+
+    /// Allocator taking memory from the solve arena.
+    template <typename T>
+    ArenaAllocator<T> allocator() const { return ArenaAllocator<T>(arena); }
+
+    /// Bytes held by the flat arrays.
+    size_t bytes() const {
+        return mem_used(video_size) + mem_used(video_req_begin) + mem_used(video_req) +
+               mem_used(req_video) + mem_used(req_endpoint) + mem_used(req_num) +
+               mem_used(ep_dc_lat) + mem_used(ep_cache_begin) + mem_used(ep_cache) +
+               mem_used(ep_cache_lat);
+    }
+
+    /// Latency from endpoint `e` to cache `c`, -1 if not connected.
+    int32_t& lat(int e, int c) { return ep_cache_lat[static_cast<size_t>(e) * C + c]; }
+    /// Latency from endpoint `e` to cache `c`, -1 if not connected.
+    int32_t lat(int e, int c) const { return ep_cache_lat[static_cast<size_t>(e) * C + c]; }
+};
+
+/**
+ * True if a dense C x V table of `save_t` savings takes at most `max_memory` bytes, 0 means no
+ * limit. Kernels switch to sparse or streamed savings otherwise.
+ */
+template <typename save_t>
+bool dense_fits(int C, int V, size_t max_memory) {
+    return max_memory == 0 || sizeof(save_t) * C * V <= max_memory;
+}
+
+/**
+ * Number of bytes a kernel run needs: the compact copy, a dense C x V savings table unless it
+ * exceeds `max_memory`, and per-video and per-cache scratch, assuming 32 bit ids and 64 bit
+ * savings.
+ */
+inline size_t solver_bytes(const Instance& inst, size_t max_memory = 0) {
+    size_t V = inst.V, E = inst.E, R = inst.R, C = inst.C;
+    size_t bytes = 4 * (2 * V + 5 * R + 3 * E + num_connections(inst) + E * C);
+    if (dense_fits<int64_t>(C, V, max_memory)) bytes += 8 * C * V;  // savings table
+    bytes += 24 * V + 8 * C;  // best caches, tuples and a row
+    bytes += 8 * V;  // placed videos, amortised growth
+    return bytes + bytes / 8 + 4096;
+}
+
+/// True if all ids of the instance (and their counts) fit in `index_t`.
+template <typename index_t>
+bool fits_index(const Instance& inst) {
+    int64_t n = std::max(std::max(inst.V, inst.E), std::max(inst.R, inst.C));
+    return n < static_cast<int64_t>(std::numeric_limits<index_t>::max());
+}
+
+/**
+ * Upper bound on any saving a single (cache, video) pair can have, i.e., the saving if all
+ * requests for a video were served with zero latency.
+ */
+inline int64_t max_saving(const Instance& inst) {
+    int64_t best = 0;
+    for (const Video& v : inst.videos) {
+        int64_t total = 0;
+        for (int rid : v.request_ids) {
+            const Request& r = inst.requests[rid];
+            total += static_cast<int64_t>(r.num_req) *
+                     inst.endpoints[r.endpoint_id].datacenter_lat;
+        }
+        best = std::max(best, total);
+    }
+    return best;
+}
+
+/**
+ * Calls `kernel.template run<index_t, save_t>(CompactInstance<index_t>)` with the narrowest of
+ * uint16_t / uint32_t ids and int32_t / int64_t savings the instance fits in.
+ * @tparam kernel_t class with a templated `run` member returning the solver result and a
+ * `max_memory` member limiting the size of dense savings tables, see dense_fits()
+ */
+template <typename kernel_t>
+std::vector<std::vector<int>> dispatch(const Instance& inst, const kernel_t& kernel) {
+    bool narrow_save = max_saving(inst) < std::numeric_limits<int32_t>::max();
+    Arena arena(solver_bytes(inst, kernel.max_memory));
+    if (fits_index<uint16_t>(inst)) {
+        CompactInstance<uint16_t> ci(inst, &arena);
+        if (narrow_save) return kernel.template run<uint16_t, int32_t>(ci);
+        return kernel.template run<uint16_t, int64_t>(ci);
+    }
+    CompactInstance<uint32_t> ci(inst, &arena);
+    if (narrow_save) return kernel.template run<uint32_t, int32_t>(ci);
+    return kernel.template run<uint32_t, int64_t>(ci);
+}
+
+}  // namespace mm
+
+#endif  // SRC_COMPACT_HPP_
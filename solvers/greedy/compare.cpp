@@ -0,0 +1,120 @@
+/**
+ * @file
+ * @brief Compares two solutions of one instance.
+ * Usage:
+ *     compare input.in a.out b.out [--limit N]
+ * Prints scores, utilisation of every cache, saved latency of every endpoint and of every
+ * requested video in both solutions, and all requests whose latency differs. `--limit` prints
+ * only the first N rows of every table, 0 for all.
+ */
+
+#include <iostream>
+#include <vector>
+#include "includes.hpp"
+#include "common.hpp"
+#include "instance.hpp"
+#include "score.hpp"
+#include "driver.hpp"
+
+using namespace mm;
+using namespace std;
+
+/// Reads and checks a solution, exits on error.
+vector<vector<int>> load_solution(const Instance& inst, const string& path) {
+    ifstream in(path);
+    if (!in.is_open()) {
+        cerr << "Cannot open solution " << path << "." << endl;
+        exit(1);
+    }
+    // rejects caches listed more than once, as the official scorer does
+    string problem;
+    vector<vector<int>> videos_per_cache = read_solution(in, inst.C, &problem);
+    if (!problem.empty()) {
+        cerr << "Cannot read solution " << path << ": " << problem << "." << endl;
+        exit(1);
+    }
+    problem = check_solution(inst, videos_per_cache);
+    if (!problem.empty()) {
+        cerr << "Invalid solution " << path << ": " << problem << "." << endl;
+        exit(1);
+    }
+    return videos_per_cache;
+}
+
+int main(int argc, char* argv[]) {
+    Options opt(argc, argv);
+    if (opt.positional.size() != 3) {
+        cerr << "Usage: compare input.in a.out b.out [--limit N]" << endl;
+        return 1;
+    }
+    int64_t limit = opt.get_int("limit", 0);
+    if (limit <= 0) limit = numeric_limits<int64_t>::max();
+    ifstream in(opt.positional[0]);
+    if (!in.is_open()) {
+        cerr << "Cannot open instance " << opt.positional[0] << "." << endl;
+        return 1;
+    }
+    Instance inst = read_instance(in);
+    if (in.fail()) {
+        cerr << "Cannot read instance " << opt.positional[0] << "." << endl;
+        return 1;
+    }
+    vector<vector<int>> sol[2] = {load_solution(inst, opt.positional[1]),
+                                  load_solution(inst, opt.positional[2])};
+
+    vector<int> latency[2];
+    vector<int64_t> endpoint_saved[2], video_saved[2];
+    for (int s = 0; s < 2; ++s) {
+        latency[s] = request_latencies(inst, sol[s]);
+        endpoint_saved[s].assign(inst.E, 0);
+        video_saved[s].assign(inst.V, 0);
+        for (int i = 0; i < inst.R; ++i) {
+            const Request& r = inst.requests[i];
+            int64_t saved = static_cast<int64_t>(inst.endpoints[r.endpoint_id].datacenter_lat -
+                                                 latency[s][i]) * r.num_req;
+            endpoint_saved[s][r.endpoint_id] += saved;
+            video_saved[s][r.video_id] += saved;
+        }
+    }
+
+    ostringstream out;
+    out << "score " << score(inst, sol[0]) << " " << score(inst, sol[1]) << "\n";
+
+    out << "\ncache used_a used_b capacity videos_a videos_b\n";
+    for (int c = 0; c < min<int64_t>(inst.C, limit); ++c) {
+        int64_t used[2] = {0, 0};
+        for (int s = 0; s < 2; ++s) {
+            for (int v : sol[s][c]) used[s] += inst.videos[v].size;
+        }
+        out << c << " " << used[0] << " " << used[1] << " " << inst.X << " " << sol[0][c].size()
+            << " " << sol[1][c].size() << "\n";
+    }
+
+    out << "\nendpoint saved_a saved_b delta\n";
+    for (int e = 0; e < min<int64_t>(inst.E, limit); ++e) {
+        out << e << " " << endpoint_saved[0][e] << " " << endpoint_saved[1][e] << " "
+            << endpoint_saved[1][e] - endpoint_saved[0][e] << "\n";
+    }
+
+    out << "\nvideo saved_a saved_b delta\n";
+    int64_t rows = 0;
+    for (int v = 0; v < inst.V && rows < limit; ++v) {
+        if (inst.videos[v].request_ids.empty()) continue;
+        out << v << " " << video_saved[0][v] << " " << video_saved[1][v] << " "
+            << video_saved[1][v] - video_saved[0][v] << "\n";
+        ++rows;
+    }
+
+    out << "\nrequest video endpoint num_req latency_a latency_b\n";
+    int64_t changed = 0;
+    for (int i = 0; i < inst.R; ++i) {
+        if (latency[0][i] == latency[1][i]) continue;
+        if (changed++ >= limit) continue;
+        const Request& r = inst.requests[i];
+        out << i << " " << r.video_id << " " << r.endpoint_id << " " << r.num_req << " "
+            << latency[0][i] << " " << latency[1][i] << "\n";
+    }
+    cout << out.str();
+    cerr << changed << " of " << inst.R << " requests changed latency." << endl;
+    return 0;
+}
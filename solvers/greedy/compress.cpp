@@ -0,0 +1,97 @@
+/**
+ * @file
+ * @brief Implementation of endpoint compression declared in compress.hpp.
+ */
+
+#include "compress.hpp"
+
+namespace mm {
+
+Compressed compress_endpoints(const Instance& inst) {
+    Compressed res;
+    int E = inst.E, R = inst.R;
+
+    // key of an endpoint: datacenter latency followed by sorted (cache, latency) pairs
+    std::map<std::vector<int>, int> class_of_key;
+    std::vector<int> first_endpoint;
+    res.endpoint_class.resize(E);
+    for (int e = 0; e < E; ++e) {
+        const Endpoint& ep = inst.endpoints[e];
+        std::vector<int> caches(ep.connected_caches.begin(), ep.connected_caches.end());
+        std::sort(caches.begin(), caches.end());
+        std::vector<int> key = {ep.datacenter_lat};
+        for (int c : caches) {
+            key.push_back(c);
+            key.push_back(ep.cache_lat[c]);
+        }
+        auto it = class_of_key.insert({key, static_cast<int>(first_endpoint.size())}).first;
+        if (it->second == static_cast<int>(first_endpoint.size())) first_endpoint.push_back(e);
+        res.endpoint_class[e] = it->second;
+    }
+    int K = first_endpoint.size();
+
+    // every request is added to the first request of the same video from the same class
+    std::vector<int> req_class(R), first(R), slot(K, -1);
+    for (int i = 0; i < R; ++i) req_class[i] = res.endpoint_class[inst.requests[i].endpoint_id];
+    for (const Video& video : inst.videos) {
+        for (int rid : video.request_ids) {
+            int& s = slot[req_class[rid]];
+            if (s == -1) s = rid;
+            first[rid] = s;
+        }
+        for (int rid : video.request_ids) slot[req_class[rid]] = -1;
+    }
+    std::vector<int> merged_index(R, -1), video_of, class_of;
+    std::vector<int64_t> total;
+    for (int i = 0; i < R; ++i) {
+        if (first[i] != i) continue;
+        merged_index[i] = total.size();
+        video_of.push_back(inst.requests[i].video_id);
+        class_of.push_back(req_class[i]);
+        total.push_back(0);
+    }
+    for (int i = 0; i < R; ++i) total[merged_index[first[i]]] += inst.requests[i].num_req;
+
+    // kernels multiply request counts by latency differences in 32 bit, which are at most the
+    // datacenter latency, so merged counts are capped to keep those products in the int range
+    int max_dc = 1;
+    for (const Endpoint& ep : inst.endpoints) max_dc = std::max(max_dc, ep.datacenter_lat);
+    const int64_t max_req = std::numeric_limits<int>::max() / max_dc;
+    int merged_R = 0;
+    for (int64_t t : total) merged_R += std::max<int64_t>(1, (t + max_req - 1) / max_req);
+
+    res.instance = Instance(inst.V, K, merged_R, inst.C, inst.X);
+    Instance& out = res.instance;
+    for (const Video& v : inst.videos) out.videos.emplace_back(v.size, out.allocator<int>());
+    for (int e : first_endpoint) {
+        const Endpoint& ep = inst.endpoints[e];
+        out.endpoints.emplace_back(ep.datacenter_lat, out.C, out.allocator<int>());
+        out.endpoints.back().connected_caches.reserve(ep.num_connected_caches);
+        for (int c : ep.connected_caches) out.endpoints.back().connect(c, ep.cache_lat[c]);
+    }
+    std::vector<int> count(inst.V, 0);
+    for (size_t j = 0; j < total.size(); ++j) {
+        int64_t left = total[j];
+        do {
+            int n = std::min(left, max_req);
+            out.requests.push_back({video_of[j], class_of[j], n});
+            count[video_of[j]]++;
+            left -= n;
+        } while (left > 0);
+    }
+    for (int v = 0; v < out.V; ++v) out.videos[v].request_ids.reserve(count[v]);
+    for (int i = 0; i < out.R; ++i) {
+        out.videos[out.requests[i].video_id].request_ids.push_back(i);
+    }
+    return res;
+}
+
+std::vector<std::vector<int>> solve_compressed(const Instance& inst, const solver_t& solver) {
+    Compressed compressed = compress_endpoints(inst);
+    std::cerr << "Compressed " << inst.E << " endpoints into " << compressed.instance.E
+              << " classes and " << inst.R << " requests into " << compressed.instance.R
+              << "." << std::endl;
+    return solver(compressed.instance);
+}
+
+}  // namespace mm
@@ -0,0 +1,37 @@
+#ifndef SRC_COMPRESS_HPP_
+#define SRC_COMPRESS_HPP_
+
+/**
+ * @file
+ * @brief Merging of interchangeable endpoints. Endpoints with the same datacenter latency and
+ * the same latency to every cache save exactly the same per request, so they can be replaced by
+ * one endpoint class whose requests for a video are summed into one weighted request. Savings,
+ * and thus solutions and scores, of the compressed instance are the same as of the original.
+ */
+
+#include "instance.hpp"
+#include "greedy.hpp"
+
+namespace mm {
+
+/// Instance with one endpoint per endpoint class and one request per (video, class).
+struct Compressed {
+    Instance instance;  ///< same videos and caches, so solutions need no mapping back
+    std::vector<int> endpoint_class;  ///< class of every original endpoint
+};
+
+/**
+ * Groups endpoints by (datacenter latency, connected caches with their latencies) and merges
+ * their requests per video. Classes are numbered in order of their first endpoint and merged
+ * requests in order of their first request, so the result depends only on the instance. Sums
+ * are split over several requests so that no request count times the largest datacenter
+ * latency exceeds the int range, which the 32 bit products of the kernels in simd.hpp need.
+ */
+Compressed compress_endpoints(const Instance& inst);
+
+/// Solves the compressed instance with `solver` and reports the reduction to stderr.
+std::vector<std::vector<int>> solve_compressed(const Instance& inst, const solver_t& solver);
+
+}  // namespace mm
+
+#endif  // SRC_COMPRESS_HPP_
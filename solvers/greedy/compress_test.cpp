@@ -0,0 +1,85 @@
+/**
+ * @file
+ * @brief Checks of compress_endpoints(): request counts and saved latency are preserved, and
+ * every solver finds the same solution on the compressed instance as on the original one, also
+ * when merged requests would overflow the 32 bit products of the savings kernels.
+ * Usage:
+ *     compress_test
+ * Prints every failed check and exits with 1 if there was any.
+ */
+
+#include <iostream>
+#include <vector>
+#include "includes.hpp"
+#include "instance.hpp"
+#include "greedy.hpp"
+#include "compress.hpp"
+#include "score.hpp"
+
+using namespace mm;
+using namespace std;
+
+int failures = 0;
+
+/// Reports a failed check with its source line.
+#define CHECK(cond)                                                                   \
+    do {                                                                              \
+        if (!(cond)) {                                                                \
+            cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #cond << endl;  \
+            ++failures;                                                               \
+        }                                                                             \
+    } while (0)
+
+/**
+ * 101 endpoints with datacenter latency 4000 and one cache at 0 ms of capacity 10. Video 0 is
+ * requested 10000 times from each of the first 100 endpoints, video 1 once from the last one,
+ * both are of size 10. Merged into one request, video 0 would save 100 * 10000 * 4000 ms,
+ * which does not fit in 32 bit.
+ */
+Instance overflow_instance() {
+    stringstream ss;
+    int E = 101;
+    ss << "2 " << E << " " << E << " 1 10\n10 10\n";
+    for (int e = 0; e < E; ++e) ss << "4000 1\n0 0\n";
+    for (int e = 0; e + 1 < E; ++e) ss << "0 " << e << " 10000\n";
+    ss << "1 " << E - 1 << " 1\n";
+    return read_instance(ss);
+}
+
+/// Compares compressed and original instance, and solutions of all solvers on both.
+void check_compression(const Instance& inst) {
+    Compressed compressed = compress_endpoints(inst);
+    const Instance& out = compressed.instance;
+    CHECK(out.V == inst.V && out.C == inst.C && out.X == inst.X);
+    int64_t total = 0, merged_total = 0, max_dc = 1;
+    for (const Request& r : inst.requests) total += r.num_req;
+    for (const Endpoint& ep : out.endpoints) max_dc = max<int64_t>(max_dc, ep.datacenter_lat);
+    bool fits = true;
+    for (const Request& r : out.requests) {
+        merged_total += r.num_req;
+        fits = fits && r.num_req * max_dc <= numeric_limits<int>::max();
+    }
+    CHECK(merged_total == total);
+    CHECK(fits);
+
+    for (const char* name : {"greedy1", "greedy1-conflict", "greedy2"}) {
+        solver_t solver = solver_by_name(name);
+        vector<vector<int>> original = solver(inst), merged = solver(out);
+        CHECK(merged == original);
+        CHECK(saved_latency(out, merged) == saved_latency(inst, merged));
+    }
+}
+
+int main() {
+    Instance inst = overflow_instance();
+    check_compression(inst);
+    // caching the heavily requested video is the only good solution
+    CHECK(greedy2(compress_endpoints(inst).instance) == vector<vector<int>>({{0}}));
+    CHECK(greedy2(inst) == vector<vector<int>>({{0}}));
+    if (failures) {
+        cerr << failures << " checks failed." << endl;
+        return 1;
+    }
+    cerr << "All checks passed." << endl;
+    return 0;
+}
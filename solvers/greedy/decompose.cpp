@@ -0,0 +1,147 @@
+/**
+ * @file
+ * @brief Implementation of instance decomposition declared in decompose.hpp.
+ */
+
+#include "decompose.hpp"
+
+namespace mm {
+
+UnionFind::UnionFind(int n) : parent(n), size(n, 1) {
+    for (int i = 0; i < n; ++i) parent[i] = i;
+}
+
+int UnionFind::find(int x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+bool UnionFind::join(int a, int b) {
+    a = find(a);
+    b = find(b);
+    if (a == b) return false;
+    if (size[a] < size[b]) std::swap(a, b);
+    parent[b] = a;
+    size[a] += size[b];
+    return true;
+}
+
+std::vector<Component> decompose(const Instance& inst) {
+    int C = inst.C, E = inst.E, V = inst.V;
+    // nodes 0 .. C-1 are caches, nodes C .. C+E-1 are endpoints
+    UnionFind uf(C + E);
+    for (int e = 0; e < E; ++e) {
+        for (int c : inst.endpoints[e].connected_caches) uf.join(C + e, c);
+    }
+
+    std::vector<bool> has_request(C + E, false);
+    for (const Request& r : inst.requests) {
+        if (inst.endpoints[r.endpoint_id].num_connected_caches > 0) {
+            has_request[uf.find(C + r.endpoint_id)] = true;
+        }
+    }
+
+    // components are numbered in order of their smallest cache id
+    std::vector<int> comp_of_root(C + E, -1);
+    std::vector<Component> comps;
+    std::vector<int> cache_local(C), endpoint_local(E, -1);
+    for (int c = 0; c < C; ++c) {
+        int root = uf.find(c);
+        if (!has_request[root]) continue;
+        if (comp_of_root[root] == -1) {
+            comp_of_root[root] = comps.size();
+            comps.emplace_back();
+        }
+        Component& comp = comps[comp_of_root[root]];
+        cache_local[c] = comp.cache_ids.size();
+        comp.cache_ids.push_back(c);
+    }
+
+    std::vector<std::vector<int>> endpoints_of(comps.size()), requests_of(comps.size());
+    for (int e = 0; e < E; ++e) {
+        if (inst.endpoints[e].num_connected_caches == 0) continue;
+        int k = comp_of_root[uf.find(C + e)];
+        if (k == -1) continue;
+        endpoint_local[e] = endpoints_of[k].size();
+        endpoints_of[k].push_back(e);
+    }
+    for (int i = 0; i < inst.R; ++i) {
+        int e = inst.requests[i].endpoint_id;
+        if (endpoint_local[e] == -1) continue;
+        requests_of[comp_of_root[uf.find(C + e)]].push_back(i);
+    }
+
+    std::vector<int> video_local(V, -1);
+    for (size_t k = 0; k < comps.size(); ++k) {
+        Component& comp = comps[k];
+        for (int rid : requests_of[k]) comp.video_ids.push_back(inst.requests[rid].video_id);
+        std::sort(comp.video_ids.begin(), comp.video_ids.end());
+        comp.video_ids.erase(std::unique(comp.video_ids.begin(), comp.video_ids.end()),
+                             comp.video_ids.end());
+        comp.instance = Instance(comp.video_ids.size(), endpoints_of[k].size(),
+                                 requests_of[k].size(), comp.cache_ids.size(), inst.X);
+        Instance& sub = comp.instance;
+
+        for (int v = 0; v < sub.V; ++v) {
+            video_local[comp.video_ids[v]] = v;
+            sub.videos.emplace_back(inst.videos[comp.video_ids[v]].size, sub.allocator<int>());
+        }
+        for (int e : endpoints_of[k]) {
+            const Endpoint& ep = inst.endpoints[e];
+            sub.endpoints.emplace_back(ep.datacenter_lat, sub.C, sub.allocator<int>());
+            sub.endpoints.back().connected_caches.reserve(ep.num_connected_caches);
+            for (int c : ep.connected_caches) {
+                sub.endpoints.back().connect(cache_local[c], ep.cache_lat[c]);
+            }
+        }
+        sub.requests.resize(sub.R);
+        std::vector<int> count(sub.V, 0);
+        for (int i = 0; i < sub.R; ++i) {
+            const Request& r = inst.requests[requests_of[k][i]];
+            sub.requests[i] = {video_local[r.video_id], endpoint_local[r.endpoint_id], r.num_req};
+            count[sub.requests[i].video_id]++;
+        }
+        for (int v = 0; v < sub.V; ++v) sub.videos[v].request_ids.reserve(count[v]);
+        for (int i = 0; i < sub.R; ++i) {
+            sub.videos[sub.requests[i].video_id].request_ids.push_back(i);
+        }
+        for (int v : comp.video_ids) video_local[v] = -1;
+    }
+    return comps;
+}
+
+std::vector<std::vector<int>> solve_by_components(const Instance& inst, const solver_t& solver) {
+    std::vector<Component> comps = decompose(inst);
+    std::cerr << "Solving " << comps.size() << " independent components." << std::endl;
+
+    // largest components first, so they do not end up last on a single thread
+    std::vector<int> order(comps.size());
+    for (size_t k = 0; k < comps.size(); ++k) order[k] = k;
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return comps[a].instance.R > comps[b].instance.R;
+    });
+
+    int n = comps.size();
+    std::vector<std::vector<std::vector<int>>> partial(n);
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int i = 0; i < n; ++i) {
+        int k = order[i];
+        partial[k] = solver(comps[k].instance);
+    }
+
+    // merged in component order, not completion order, so the output does not depend on scheduling
+    std::vector<std::vector<int>> videos_per_cache(inst.C);
+    for (int k = 0; k < n; ++k) {
+        const Component& comp = comps[k];
+        for (size_t c = 0; c < comp.cache_ids.size(); ++c) {
+            std::vector<int>& out = videos_per_cache[comp.cache_ids[c]];
+            for (int v : partial[k][c]) out.push_back(comp.video_ids[v]);
+        }
+    }
+    return videos_per_cache;
+}
+
+}  // namespace mm
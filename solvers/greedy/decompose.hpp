@@ -0,0 +1,50 @@
+#ifndef SRC_DECOMPOSE_HPP_
+#define SRC_DECOMPOSE_HPP_
+
+/**
+ * @file
+ * @brief Splitting of an instance into independent subproblems. Caches that share no endpoints
+ * (directly or through other caches) do not influence each other, so every connected component
+ * of the endpoint--cache graph can be solved on its own.
+ */
+
+#include "instance.hpp"
+#include "greedy.hpp"
+
+namespace mm {
+
+/// Disjoint set union with path halving and union by size.
+class UnionFind {
+    std::vector<int> parent, size;
+  public:
+    /// Creates `n` singleton sets.
+    explicit UnionFind(int n);
+    /// Representative of the set containing `x`.
+    int find(int x);
+    /// Joins sets containing `a` and `b`. Returns false if they were already joined.
+    bool join(int a, int b);
+};
+
+/// One connected component as a standalone instance, with maps back to original ids.
+struct Component {
+    Instance instance;  ///< subproblem with caches, endpoints and videos renumbered from 0
+    std::vector<int> cache_ids;  ///< original id of every cache in the subproblem
+    std::vector<int> video_ids;  ///< original id of every video in the subproblem
+};
+
+/**
+ * Finds connected components of the endpoint--cache graph. Only components with at least one
+ * cache and one request are returned, since nothing can be saved elsewhere. Caches, endpoints,
+ * videos and requests keep their relative order inside each component.
+ */
+std::vector<Component> decompose(const Instance& inst);
+
+/**
+ * Decomposes the instance, solves every component with `solver` in parallel and merges
+ * the per-cache results back into original numbering.
+ */
+std::vector<std::vector<int>> solve_by_components(const Instance& inst, const solver_t& solver);
+
+}  // namespace mm
+
+#endif  // SRC_DECOMPOSE_HPP_
@@ -0,0 +1,81 @@
+/**
+ * @file
+ * @brief Implementation of executable helpers declared in driver.hpp.
+ */
+
+#include "driver.hpp"
+#include "common.hpp"
+
+namespace mm {
+
+namespace {
+
+/// Flags that never take a value, so `--memory-report in.in` keeps `in.in` positional.
+const std::set<std::string> switches = {"memory-report", "reorder", "compress", "prune",
+                                        "conflict-aware", "parse"};
+
+}  // namespace
+
+Options::Options(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.size() > 2 && arg.compare(0, 2, "--") == 0) {
+            std::string name = arg.substr(2);
+            if (!switches.count(name) && i + 1 < argc &&
+                std::string(argv[i + 1]).compare(0, 2, "--") != 0) {
+                flags_[name] = argv[++i];
+            } else {
+                flags_[name] = "1";
+            }
+        } else {
+            positional.push_back(arg);
+        }
+    }
+    seed_ = has("seed") ? static_cast<unsigned int>(get_int("seed", 0)) : get_seed();
+    if (has("threads")) omp_set_num_threads(get_int("threads", 1));
+}
+
+bool Options::has(const std::string& name) const { return flags_.count(name) > 0; }
+
+std::string Options::get(const std::string& name, const std::string& def) const {
+    auto it = flags_.find(name);
+    return it == flags_.end() ? def : it->second;
+}
+
+int64_t Options::get_int(const std::string& name, int64_t def) const {
+    return has(name) ? std::stoll(get(name, "")) : def;
+}
+
+double Options::get_double(const std::string& name, double def) const {
+    return has(name) ? std::stod(get(name, "")) : def;
+}
+
+unsigned int derive_seed(unsigned int seed, uint64_t stream) {
+    uint64_t z = (static_cast<uint64_t>(seed) << 32) + stream + 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return static_cast<unsigned int>(z ^ (z >> 31));
+}
+
+std::vector<std::vector<int>> solve_verified(const solver_t& solver, const Instance& inst,
+                                             int runs, bool& ok) {
+    ok = true;
+    std::vector<std::vector<int>> first = solver(inst);
+    if (runs <= 1) return first;
+    uint64_t expected = hash_solution(first);
+    for (int run = 1; run < runs; ++run) {
+        uint64_t h = hash_solution(solver(inst));
+        if (h != expected) {
+            std::cerr << "Determinism check failed: run " << run << " has hash " << std::hex << h
+                      << ", run 0 has " << expected << std::dec << std::endl;
+            ok = false;
+        }
+    }
+    if (ok) {
+        std::cerr << "Determinism check passed: " << runs << " runs, hash " << std::hex
+                  << expected << std::dec << std::endl;
+    }
+    return first;
+}
+
+}  // namespace mm
@@ -0,0 +1,71 @@
+#ifndef SRC_DRIVER_HPP_
+#define SRC_DRIVER_HPP_
+
+/**
+ * @file
+ * @brief Helpers shared by solver executables: command line options, seeding and checking that
+ * parallel solves are reproducible.
+ */
+
+#include "instance.hpp"
+#include "greedy.hpp"
+
+namespace mm {
+
+/**
+ * Command line flags of the form `--name value` or `--name`, other arguments are positional.
+ * Switches, flags that never take a value, are listed in driver.cpp; any other flag takes the
+ * next argument as value unless it starts with `--`.
+ * Flags recognised by all executables using Options, i.e., all but batch:
+ *  - `--seed S`: seed of all randomised parts, random if not given
+ *  - `--threads N`: number of OpenMP threads
+ *
+ * and by greedy1 and greedy2:
+ *  - `--verify-determinism N`: solve N times and check all results are identical
+ *  - `--max-memory B`: limit on dense savings tables, see parse_bytes() for the format
+ *  - `--memory-report`: print bytes held by solver structures after every phase
+ *  - `--reorder`: solve a copy renumbered for memory locality, see reorder()
+ *  - `--compress`: solve a copy with interchangeable endpoints merged, see compress_endpoints()
+ */
+class Options {
+  public:
+    /// Parses arguments and applies `--threads`.
+    Options(int argc, char* argv[]);
+
+    /// True if flag was given.
+    bool has(const std::string& name) const;
+    /// Value of flag, `def` if not given.
+    std::string get(const std::string& name, const std::string& def) const;
+    /// Integer value of flag, `def` if not given.
+    int64_t get_int(const std::string& name, int64_t def) const;
+    /// Floating point value of flag, `def` if not given.
+    double get_double(const std::string& name, double def) const;
+    /// Value of `--seed`, or a random seed chosen once at construction.
+    unsigned int seed() const { return seed_; }
+
+    std::vector<std::string> positional;  ///< arguments that are not flags
+
+  private:
+    std::map<std::string, std::string> flags_;
+    unsigned int seed_;
+};
+
+/**
+ * Seed for the `stream`-th independent unit of work (a component, an island, ...), derived
+ * from `seed` with splitmix64. Seeding per unit of work instead of per thread keeps results
+ * independent of scheduling.
+ */
+unsigned int derive_seed(unsigned int seed, uint64_t stream);
+
+/**
+ * Solves `inst` with `solver` once, or `runs` times if `runs` > 1 and checks that hashes of all
+ * results are the same. Mismatches are reported on stderr.
+ * @param ok set to false if results differ
+ * @return Result of the first run.
+ */
+std::vector<std::vector<int>> solve_verified(const solver_t& solver, const Instance& inst,
+                                             int runs, bool& ok);
+
+}  // namespace mm
+
+#endif  // SRC_DRIVER_HPP_
@@ -0,0 +1,15 @@
+#include <iostream>
+#include <vector>
+#include "includes.hpp"
+#include "common.hpp"
+#include "instance.hpp"
+#include "popularity.hpp"
+
+using namespace mm;
+using namespace std;
+
+int main() {
+    Instance inst = read_instance(cin);
+    write_solution(cout, popularity_fill(inst));
+    return 0;
+}
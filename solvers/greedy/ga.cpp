@@ -0,0 +1,48 @@
+/**
+ * @file
+ * @brief Island genetic optimiser seeded with greedy1, conflict aware greedy1, greedy2 and the
+ * popularity fill of fill.py.
+ * Usage:
+ *     ga [--islands K] [--population P] [--generations G] [--migrate-every M]
+ *        [--time-limit S] [--seed N] < input.in > output.out
+ */
+
+#include <iostream>
+#include <vector>
+#include "includes.hpp"
+#include "common.hpp"
+#include "instance.hpp"
+#include "greedy.hpp"
+#include "decompose.hpp"
+#include "driver.hpp"
+#include "genetic.hpp"
+#include "popularity.hpp"
+#include "score.hpp"
+
+using namespace mm;
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    Options opt(argc, argv);
+    GeneticParams params;
+    params.islands = opt.get_int("islands", params.islands);
+    params.population = opt.get_int("population", params.population);
+    params.generations = opt.get_int("generations", params.generations);
+    params.migrate_every = opt.get_int("migrate-every", params.migrate_every);
+    params.time_limit = opt.get_double("time-limit", params.time_limit);
+    params.seed = opt.seed();
+    Instance inst = read_instance(cin);
+
+    vector<vector<vector<int>>> seeds;
+    for (const char* name : {"greedy1", "greedy1-conflict", "greedy2"}) {
+        seeds.push_back(solve_by_components(inst, solver_by_name(name)));
+        cerr << name << ": " << score(inst, seeds.back()) << endl;
+    }
+    seeds.push_back(popularity_fill(inst));
+    cerr << "fill: " << score(inst, seeds.back()) << endl;
+
+    vector<vector<int>> videos_per_cache = genetic(inst, seeds, params);
+    cerr << "ga: " << score(inst, videos_per_cache) << endl;
+    write_solution(cout, videos_per_cache);
+    return 0;
+}
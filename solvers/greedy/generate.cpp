@@ -0,0 +1,48 @@
+/**
+ * @file
+ * @brief Writes a random instance to standard output.
+ * Usage:
+ *     generate V E R C X [--zipf S] [--latency uniform|normal] [--max-caches K] [--seed N]
+ * See GeneratorParams for the meaning and defaults of the options.
+ */
+
+#include <iostream>
+#include <vector>
+#include "includes.hpp"
+#include "common.hpp"
+#include "generator.hpp"
+#include "driver.hpp"
+
+using namespace mm;
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    Options opt(argc, argv);
+    if (opt.positional.size() != 5) {
+        cerr << "Usage: generate V E R C X [--zipf S] [--latency uniform|normal] "
+             << "[--max-caches K] [--seed N]" << endl;
+        return 1;
+    }
+    GeneratorParams params;
+    params.V = stoi(opt.positional[0]);
+    params.E = stoi(opt.positional[1]);
+    params.R = stoi(opt.positional[2]);
+    params.C = stoi(opt.positional[3]);
+    params.X = stoi(opt.positional[4]);
+    params.zipf = opt.get_double("zipf", params.zipf);
+    string latency = opt.get("latency", "uniform");
+    if (latency != "uniform" && latency != "normal") {
+        cerr << "Unknown latency distribution " << latency << "." << endl;
+        return 1;
+    }
+    if (latency == "normal") params.latency = LatencyDistribution::normal;
+    params.max_caches = opt.get_int("max-caches", params.max_caches);
+    params.seed = opt.seed();
+    if (params.V <= 0 || params.E <= 0 || params.R < 0 || params.C <= 0 || params.X <= 0) {
+        cerr << "V, E, C and X must be positive and R non-negative." << endl;
+        return 1;
+    }
+    ios::sync_with_stdio(false);
+    write_random_instance(cout, params);
+    return 0;
+}
@@ -0,0 +1,164 @@
+/**
+ * @file
+ * @brief Implementation of random instances declared in generator.hpp.
+ */
+
+#include "generator.hpp"
+
+namespace mm {
+
+namespace {
+
+/// Output buffer formatting integers by hand, to write large instances at disk speed.
+class BufferedWriter {
+  public:
+    explicit BufferedWriter(std::ostream& os) : os_(os), buffer_(1 << 20), pos_(0) {}
+    ~BufferedWriter() { flush(); }
+
+    /// Appends a non-negative number followed by `sep`.
+    void put(int64_t x, char sep) {
+        if (pos_ + 24 > buffer_.size()) flush();
+        char digits[20];
+        int n = 0;
+        do {
+            digits[n++] = '0' + x % 10;
+            x /= 10;
+        } while (x > 0);
+        while (n > 0) buffer_[pos_++] = digits[--n];
+        buffer_[pos_++] = sep;
+    }
+
+    /// Writes the buffered text to the stream.
+    void flush() {
+        os_.write(buffer_.data(), pos_);
+        pos_ = 0;
+    }
+
+  private:
+    std::ostream& os_;
+    std::vector<char> buffer_;
+    size_t pos_;
+};
+
+}  // namespace
+
+InstanceGenerator::InstanceGenerator(const GeneratorParams& params)
+        : params_(params), rng_(params.seed), accept_(params.V, 1.0), alias_(params.V),
+          video_of_rank_(params.V), caches_(params.C) {
+    assert(params.V > 0 && params.E > 0 && params.C > 0 && params.X > 0);
+    // Vose's alias method: every rank keeps weight accept_[k] and gets the rest from alias_[k]
+    std::vector<double> weight(params.V);
+    double total = 0;
+    for (int k = 0; k < params.V; ++k) {
+        weight[k] = 1.0 / std::pow(k + 1.0, params.zipf);
+        total += weight[k];
+    }
+    std::vector<int> small, large;
+    for (int k = 0; k < params.V; ++k) {
+        weight[k] *= params.V / total;
+        alias_[k] = k;
+        (weight[k] < 1.0 ? small : large).push_back(k);
+    }
+    while (!small.empty() && !large.empty()) {
+        int s = small.back(), l = large.back();
+        small.pop_back();
+        accept_[s] = weight[s];
+        alias_[s] = l;
+        weight[l] -= 1.0 - weight[s];
+        if (weight[l] < 1.0) {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+    for (int v = 0; v < params.V; ++v) video_of_rank_[v] = v;
+    std::shuffle(video_of_rank_.begin(), video_of_rank_.end(), rng_);
+    for (int c = 0; c < params.C; ++c) caches_[c] = c;
+}
+
+int InstanceGenerator::video_size() {
+    return std::uniform_int_distribution<int>(1, 1000)(rng_);
+}
+
+int InstanceGenerator::endpoint(std::vector<std::pair<int, int>>& connections) {
+    int dc;
+    if (params_.latency == LatencyDistribution::normal) {
+        double x = std::normal_distribution<double>(1000, 300)(rng_);
+        dc = static_cast<int>(std::min(4000.0, std::max(2.0, std::round(x))));
+    } else {
+        dc = std::uniform_int_distribution<int>(2, 4000)(rng_);
+    }
+    int k = std::uniform_int_distribution<int>(0, std::min(params_.C, params_.max_caches))(rng_);
+    // partial Fisher-Yates shuffle picks k distinct caches
+    connections.clear();
+    for (int i = 0; i < k; ++i) {
+        std::swap(caches_[i], caches_[std::uniform_int_distribution<int>(i, params_.C - 1)(rng_)]);
+        connections.emplace_back(caches_[i], std::uniform_int_distribution<int>(1, dc - 1)(rng_));
+    }
+    return dc;
+}
+
+Request InstanceGenerator::request() {
+    int rank = std::uniform_int_distribution<int>(0, params_.V - 1)(rng_);
+    if (std::uniform_real_distribution<double>(0, 1)(rng_) >= accept_[rank]) rank = alias_[rank];
+    Request r;
+    r.video_id = video_of_rank_[rank];
+    r.endpoint_id = std::uniform_int_distribution<int>(0, params_.E - 1)(rng_);
+    r.num_req = std::uniform_int_distribution<int>(1, 10000)(rng_);
+    return r;
+}
+
+void write_random_instance(std::ostream& os, const GeneratorParams& params) {
+    InstanceGenerator gen(params);
+    BufferedWriter out(os);
+    out.put(params.V, ' ');
+    out.put(params.E, ' ');
+    out.put(params.R, ' ');
+    out.put(params.C, ' ');
+    out.put(params.X, '\n');
+    for (int v = 0; v < params.V; ++v) out.put(gen.video_size(), v + 1 < params.V ? ' ' : '\n');
+    std::vector<std::pair<int, int>> connections;
+    for (int e = 0; e < params.E; ++e) {
+        out.put(gen.endpoint(connections), ' ');
+        out.put(connections.size(), '\n');
+        for (const std::pair<int, int>& conn : connections) {
+            out.put(conn.first, ' ');
+            out.put(conn.second, '\n');
+        }
+    }
+    for (int i = 0; i < params.R; ++i) {
+        Request r = gen.request();
+        out.put(r.video_id, ' ');
+        out.put(r.endpoint_id, ' ');
+        out.put(r.num_req, '\n');
+    }
+}
+
+Instance random_instance(const GeneratorParams& params) {
+    InstanceGenerator gen(params);
+    Instance inst(params.V, params.E, params.R, params.C, params.X);
+    for (int v = 0; v < params.V; ++v) {
+        inst.videos.emplace_back(gen.video_size(), inst.allocator<int>());
+    }
+    std::vector<std::pair<int, int>> connections;
+    for (int e = 0; e < params.E; ++e) {
+        int dc = gen.endpoint(connections);
+        inst.endpoints.emplace_back(dc, params.C, inst.allocator<int>());
+        inst.endpoints.back().connected_caches.reserve(connections.size());
+        for (const std::pair<int, int>& conn : connections) {
+            inst.endpoints.back().connect(conn.first, conn.second);
+        }
+    }
+    inst.requests.resize(params.R);
+    std::vector<int> count(params.V, 0);
+    for (int i = 0; i < params.R; ++i) {
+        inst.requests[i] = gen.request();
+        count[inst.requests[i].video_id]++;
+    }
+    for (int v = 0; v < params.V; ++v) inst.videos[v].request_ids.reserve(count[v]);
+    for (int i = 0; i < params.R; ++i) {
+        inst.videos[inst.requests[i].video_id].request_ids.push_back(i);
+    }
+    return inst;
+}
+
+}  // namespace mm
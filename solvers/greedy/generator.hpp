@@ -0,0 +1,68 @@
+#ifndef SRC_GENERATOR_HPP_
+#define SRC_GENERATOR_HPP_
+
+/**
+ * @file
+ * @brief Random instances of any size for scale testing, with Zipf distributed video popularity.
+ * All values stay within the limits of the original problem statement.
+ */
+
+#include "instance.hpp"
+
+namespace mm {
+
+/// Distribution of datacenter latencies.
+enum class LatencyDistribution {
+    uniform,  ///< uniform in [2, 4000] ms
+    normal,  ///< normal with mean 1000 ms and deviation 300 ms, clipped to [2, 4000] ms
+};
+
+/// Parameters of generated instances.
+struct GeneratorParams {
+    int V, E, R, C, X;  ///< header counts and cache capacity in MB
+    double zipf;  ///< skew of video popularity, the k-th most popular video has weight 1/k^zipf
+    LatencyDistribution latency;  ///< distribution of datacenter latencies
+    int max_caches;  ///< every endpoint connects to a uniform number of caches up to this
+    unsigned int seed;  ///< same seed and parameters give the same instance
+
+    GeneratorParams() : V(0), E(0), R(0), C(0), X(0), zipf(1.0),
+                        latency(LatencyDistribution::uniform), max_caches(10), seed(0) {}
+};
+
+/**
+ * Draws all parts of an instance in input order: video sizes, endpoints with their connections,
+ * then requests. Sizes are uniform in [1, 1000] MB, cache latencies uniform below datacenter
+ * latency, endpoints of requests uniform and request counts uniform in [1, 10000]. Videos are
+ * drawn by popularity from an alias table in O(1) per request, popularity ranks are shuffled
+ * over video ids.
+ */
+class InstanceGenerator {
+  public:
+    /// Generator of instances with `params`, which must have positive counts.
+    explicit InstanceGenerator(const GeneratorParams& params);
+
+    /// Size of the next video in MB.
+    int video_size();
+    /// Next endpoint: datacenter latency and (cache, latency) pairs with distinct caches.
+    int endpoint(std::vector<std::pair<int, int>>& connections);
+    /// Next request.
+    Request request();
+
+  private:
+    GeneratorParams params_;
+    std::mt19937 rng_;
+    std::vector<double> accept_;  ///< probability of keeping the drawn rank in the alias table
+    std::vector<int> alias_;  ///< rank taken instead otherwise
+    std::vector<int> video_of_rank_;
+    std::vector<int> caches_;  ///< scratch for sampling distinct caches
+};
+
+/// Writes a random instance in the input format to `os`, without building it in memory.
+void write_random_instance(std::ostream& os, const GeneratorParams& params);
+
+/// Random instance, the same as write_random_instance() writes for the same parameters.
+Instance random_instance(const GeneratorParams& params);
+
+}  // namespace mm
+
+#endif  // SRC_GENERATOR_HPP_
@@ -0,0 +1,170 @@
+/**
+ * @file
+ * @brief Implementation of the genetic optimiser declared in genetic.hpp.
+ */
+
+#include "genetic.hpp"
+#include "local_search.hpp"
+#include "driver.hpp"
+
+namespace mm {
+
+namespace {
+
+/// Empties cache `c` and fills it with `videos` by decreasing saving per MB, as long as they fit.
+void refill(Placement& p, int c, const std::vector<int>& videos) {
+    const Instance& inst = p.instance();
+    p.clear(c);
+    std::vector<std::pair<double, int>> order;
+    for (int v : videos) {
+        order.push_back({-static_cast<double>(p.gain_add(c, v)) / inst.videos[v].size, v});
+    }
+    std::sort(order.begin(), order.end());
+    for (const auto& item : order) {
+        int v = item.second;
+        if (!p.contains(c, v) && inst.videos[v].size <= p.space_left(c)) p.add(c, v);
+    }
+}
+
+/// One population evolved on its own thread with its own generator.
+class Island {
+  public:
+    Island(const std::vector<Placement>& seeds, int size, unsigned int seed) : rng_(seed) {
+        MoveScratch scratch;
+        for (int i = 0; i < size; ++i) {
+            population_.push_back(seeds[i % seeds.size()]);
+            if (i >= static_cast<int>(seeds.size())) perturb(population_.back(), 3, scratch);
+        }
+    }
+
+    /// Breeds `generations` children, stops early if `stop()` returns true.
+    void evolve(int generations, const std::function<bool()>& stop) {
+        MoveScratch scratch;
+        for (int g = 0; g < generations && !stop(); ++g) {
+            const Placement& a = tournament();
+            const Placement& b = tournament();
+            Placement child = crossover(a, b);
+            if (std::uniform_real_distribution<double>(0, 1)(rng_) < 0.3) {
+                perturb(child, 1, scratch);
+            }
+            int worst = this->worst();
+            if (child.saved() <= population_[worst].saved()) continue;
+            bool duplicate = false;
+            for (const Placement& p : population_) duplicate |= p.saved() == child.saved();
+            if (!duplicate) population_[worst] = std::move(child);
+        }
+    }
+
+    /// Best solution of the island.
+    const Placement& best() const {
+        int best = 0;
+        for (size_t i = 1; i < population_.size(); ++i) {
+            if (population_[i].saved() > population_[best].saved()) best = i;
+        }
+        return population_[best];
+    }
+
+    /// Replaces the worst solution with `p` if it is better.
+    void accept(const Placement& p) {
+        int worst = this->worst();
+        if (p.saved() > population_[worst].saved()) population_[worst] = p;
+    }
+
+  private:
+    int worst() const {
+        int worst = 0;
+        for (size_t i = 1; i < population_.size(); ++i) {
+            if (population_[i].saved() < population_[worst].saved()) worst = i;
+        }
+        return worst;
+    }
+
+    /// Better of two random solutions.
+    const Placement& tournament() {
+        std::uniform_int_distribution<int> pick(0, population_.size() - 1);
+        const Placement& a = population_[pick(rng_)];
+        const Placement& b = population_[pick(rng_)];
+        return a.saved() >= b.saved() ? a : b;
+    }
+
+    /// Takes every cache from `a`, from `b`, or the best of both that fits.
+    Placement crossover(const Placement& a, const Placement& b) {
+        Placement child = a;
+        std::vector<int> videos;
+        std::uniform_int_distribution<int> pick(0, 2);
+        for (int c = 0; c < a.instance().C; ++c) {
+            int from = pick(rng_);
+            if (from == 0) continue;
+            videos = b.videos(c);
+            if (from == 2) videos.insert(videos.end(), a.videos(c).begin(), a.videos(c).end());
+            refill(child, c, videos);
+        }
+        return child;
+    }
+
+    /// Empties `k` random caches and fills them again with local search.
+    void perturb(Placement& p, int k, MoveScratch& scratch) {
+        int C = p.instance().C;
+        if (C == 0) return;
+        std::uniform_int_distribution<int> pick(0, C - 1);
+        for (int i = 0; i < k; ++i) {
+            int c = pick(rng_);
+            p.clear(c);
+            improve_cache(p, c, scratch);
+        }
+    }
+
+    std::mt19937 rng_;
+    std::vector<Placement> population_;
+};
+
+}  // namespace
+
+std::vector<std::vector<int>> genetic(const Instance& inst,
+                                      const std::vector<std::vector<std::vector<int>>>& seeds,
+                                      const GeneticParams& params) {
+    auto start = std::chrono::steady_clock::now();
+    auto stop = [&]() {
+        return params.time_limit > 0 && std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count() >= params.time_limit;
+    };
+    std::vector<Placement> initial;
+    for (const auto& s : seeds) initial.emplace_back(inst, s);
+
+    int n = std::max(1, params.islands);
+    std::vector<std::unique_ptr<Island>> islands(n);
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int i = 0; i < n; ++i) {
+        islands[i].reset(new Island(initial, std::max(2, params.population),
+                                    derive_seed(params.seed, i)));
+    }
+
+    int step = std::max(1, params.migrate_every);
+    for (int g = 0; g < params.generations && !stop(); g += step) {
+        int generations = std::min(step, params.generations - g);
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (int i = 0; i < n; ++i) {
+            islands[i]->evolve(generations, stop);
+            if (params.incumbent) {
+                const Placement& best = islands[i]->best();
+                params.incumbent->offer(best.saved(), best.videos_per_cache());
+            }
+        }
+
+        // island bests move on in a ring, collected first so every island sends its own
+        std::vector<Placement> bests;
+        for (int i = 0; i < n; ++i) bests.push_back(islands[i]->best());
+        for (int i = 0; i < n; ++i) islands[(i + 1) % n]->accept(bests[i]);
+        int64_t best = 0;
+        for (const Placement& p : bests) best = std::max(best, p.score());
+        std::cerr << "Generation " << g + generations << ": best score " << best << std::endl;
+    }
+
+    const Placement* best = &islands[0]->best();
+    for (int i = 1; i < n; ++i) {
+        if (islands[i]->best().saved() > best->saved()) best = &islands[i]->best();
+    }
+    return best->videos_per_cache();
+}
+
+}  // namespace mm
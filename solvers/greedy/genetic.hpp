@@ -0,0 +1,44 @@
+#ifndef SRC_GENETIC_HPP_
+#define SRC_GENETIC_HPP_
+
+/**
+ * @file
+ * @brief Island genetic optimiser over solutions of constructive heuristics.
+ */
+
+#include "placement.hpp"
+#include "incumbent.hpp"
+
+namespace mm {
+
+/// Parameters of genetic().
+struct GeneticParams {
+    int islands;  ///< number of independent populations, evolved in parallel
+    int population;  ///< solutions per island
+    int generations;  ///< children bred on every island
+    int migrate_every;  ///< generations between migrations of island bests
+    double time_limit;  ///< stop after this many seconds, 0 for no limit
+    unsigned int seed;  ///< seed of island generators, see derive_seed()
+    Incumbent* incumbent;  ///< if set, islands offer their best here after every epoch
+
+    GeneticParams() : islands(4), population(12), generations(200), migrate_every(10),
+                      time_limit(0), seed(0), incumbent(nullptr) {}
+};
+
+/**
+ * Evolves populations seeded with `seeds` and their randomised variants, where some caches are
+ * emptied and refilled by local search. Children take every cache from one parent or from
+ * both, keeping videos with the highest saving per MB that fit into the cache. Some children are
+ * mutated by emptying and refilling a random cache. Every `migrate_every` generations the best
+ * solution of every island replaces the worst one of the next island. Islands run on OpenMP
+ * threads; without a time limit the result only depends on the seed and the parameters.
+ * @param seeds valid solutions, at least one
+ * @return Best solution found.
+ */
+std::vector<std::vector<int>> genetic(const Instance& inst,
+                                      const std::vector<std::vector<std::vector<int>>>& seeds,
+                                      const GeneticParams& params);
+
+}  // namespace mm
+
+#endif  // SRC_GENETIC_HPP_
@@ -0,0 +1,694 @@
+/**
+ * @file
+ * @brief Implementation of greedy solvers declared in greedy.hpp.
+ */
+
+#include "greedy.hpp"
+#include "compact.hpp"
+#include "simd.hpp"
+#include "savings.hpp"
+#include "parallel.hpp"
+#include "common.hpp"
+#include "memory.hpp"
+
+namespace mm {
+
+namespace {
+
+/// Returns `n` empty arena backed rows.
+template <typename T, typename index_t>
+avector<avector<T>> empty_rows(const CompactInstance<index_t>& ci, int n) {
+    avector<avector<T>> rows(ci.template allocator<avector<T>>());
+    rows.reserve(n);
+    for (int i = 0; i < n; ++i) rows.emplace_back(ci.template allocator<T>());
+    return rows;
+}
+
+/// Converts list of videos per cache from narrow ids back to int.
+template <typename index_t>
+std::vector<std::vector<int>> to_int(const avector<avector<index_t>>& videos_per_cache) {
+    std::vector<std::vector<int>> ret(videos_per_cache.size());
+    for (size_t c = 0; c < videos_per_cache.size(); ++c) {
+        ret[c].assign(videos_per_cache[c].begin(), videos_per_cache[c].end());
+    }
+    return ret;
+}
+
+/// Endpoints connected to every cache and requests from every endpoint.
+template <typename index_t>
+struct CacheIndex {
+    avector<uint32_t> cache_ep_begin;  ///< endpoints of c are in [begin[c], begin[c+1])
+    avector<index_t> cache_ep;  ///< connected endpoints grouped by cache
+    avector<uint32_t> ep_req_begin;  ///< requests from e are in [begin[e], begin[e+1])
+    avector<index_t> ep_req;  ///< request ids grouped by endpoint
+
+    explicit CacheIndex(const CompactInstance<index_t>& ci)
+            : cache_ep_begin(ci.C + 1, 0, ci.template allocator<uint32_t>()),
+              cache_ep(ci.ep_cache.size(), 0, ci.template allocator<index_t>()),
+              ep_req_begin(ci.E + 1, 0, ci.template allocator<uint32_t>()),
+              ep_req(ci.R, 0, ci.template allocator<index_t>()) {
+        for (index_t c : ci.ep_cache) ++cache_ep_begin[c + 1];
+        for (int c = 0; c < ci.C; ++c) cache_ep_begin[c + 1] += cache_ep_begin[c];
+        avector<uint32_t> next(cache_ep_begin.begin(), cache_ep_begin.end() - 1,
+                               ci.template allocator<uint32_t>());
+        for (int e = 0; e < ci.E; ++e) {
+            for (uint32_t j = ci.ep_cache_begin[e]; j < ci.ep_cache_begin[e+1]; ++j) {
+                cache_ep[next[ci.ep_cache[j]]++] = e;
+            }
+        }
+        for (int r = 0; r < ci.R; ++r) ++ep_req_begin[ci.req_endpoint[r] + 1];
+        for (int e = 0; e < ci.E; ++e) ep_req_begin[e + 1] += ep_req_begin[e];
+        next.assign(ep_req_begin.begin(), ep_req_begin.end() - 1);
+        for (int r = 0; r < ci.R; ++r) ep_req[next[ci.req_endpoint[r]]++] = r;
+    }
+
+    /// Bytes held by the index.
+    size_t bytes() const {
+        return mem_used(cache_ep_begin) + mem_used(cache_ep) + mem_used(ep_req_begin) +
+               mem_used(ep_req);
+    }
+};
+
+/**
+ * Computes one row of the savings table, savings of all videos on cache `c`, without building
+ * the table. Requests with `current_latency` below datacenter latency save only the difference,
+ * like savings decreased by greedy1_conflict_aware, or null for datacenter latency everywhere.
+ */
+template <typename index_t, typename save_t>
+void calc_cache_savings(const CompactInstance<index_t>& ci, const CacheIndex<index_t>& index,
+                        int c, const int32_t* current_latency, save_t* row) {
+    std::fill_n(row, ci.V, 0);
+    for (uint32_t j = index.cache_ep_begin[c]; j < index.cache_ep_begin[c+1]; ++j) {
+        index_t e = index.cache_ep[j];
+        int32_t dc = ci.ep_dc_lat[e], lat = ci.lat(e, c);
+        for (uint32_t k = index.ep_req_begin[e]; k < index.ep_req_begin[e+1]; ++k) {
+            index_t rid = index.ep_req[k];
+            index_t v = ci.req_video[rid];
+            if (ci.video_size[v] > ci.X) continue;
+            int32_t cur = current_latency ? current_latency[rid] : dc;
+            row[v] += static_cast<save_t>(ci.req_num[rid]) *
+                      (lat > dc ? dc - lat : std::max(0, cur - lat));
+        }
+    }
+}
+
+/**
+ * Savings of all (cache, video) pairs stored in `layout`. Video major columns are accumulated in
+ * place, cache major rows are computed one cache at a time and tiles are filled from columns.
+ */
+template <typename index_t, typename save_t>
+SavingsMatrix<save_t> calc_savings(const CompactInstance<index_t>& ci, SavingsLayout layout) {
+    int C = ci.C, V = ci.V, X = ci.X;
+    SavingsMatrix<save_t> savings(C, V, layout, ci.template allocator<save_t>());
+    if (layout == SavingsLayout::cache_major) {
+        CacheIndex<index_t> index(ci);
+        for (int c = 0; c < C; ++c) {
+            calc_cache_savings<index_t, save_t>(ci, index, c, nullptr, savings.row(c));
+        }
+        return savings;
+    }
+    bool tiled = layout == SavingsLayout::tiled;
+    avector<save_t> buffer(tiled ? C : 0, 0, ci.template allocator<save_t>());
+    for (int v = 0; v < V; ++v) {
+        if (ci.video_size[v] > X) continue;  // video ne gre v cache
+        save_t* column = tiled ? buffer.data() : savings.column(v);
+        std::fill_n(column, C, 0);
+        for (uint32_t k = ci.video_req_begin[v]; k < ci.video_req_begin[v+1]; ++k) {
+            index_t rid = ci.video_req[k];  // requesti, ki zelijo ta video
+            index_t e = ci.req_endpoint[rid];
+            // prispevek za vse cache, s katerimi smo povezani
+            simd::accumulate_savings(column, &ci.ep_cache_lat[static_cast<size_t>(e) * C],
+                                     ci.ep_dc_lat[e], ci.req_num[rid], C);
+        }
+        if (tiled) {
+            for (int c = 0; c < C; ++c) savings(c, v) = column[c];
+        }
+    }
+    return savings;
+}
+
+/**
+ * Savings of every video stored only for caches connected to an endpoint requesting it, sorted
+ * by cache. Savings on all other caches are zero and never worth a placement. With pruning, also
+ * caches no faster than the datacenter for every requesting endpoint they connect to are left
+ * out, since the datacenter always serves those endpoints at least as fast.
+ *
+ * Pruning also leaves out caches dominated by a roomy cache of the same video. Cache `d`
+ * dominates `c` if every requesting endpoint `c` serves faster than the datacenter is served
+ * by `d` even faster. Then `d` saves strictly more than `c` whenever `c` saves anything, so the
+ * greedy puts the video on `d` first, after which `c` saves nothing. That only holds if `d`
+ * has room for the video, so `d` must be roomy: all videos with an entry on it fit at once.
+ */
+template <typename index_t, typename save_t>
+struct SparseSavings {
+    avector<uint32_t> begin;  ///< entries of v are in [begin[v], begin[v+1])
+    avector<index_t> cache;
+    avector<save_t> save;
+    int64_t oversized;  ///< pairs left out because the video is larger than a cache
+    int64_t unreachable;  ///< pairs left out because no requesting endpoint connects to the cache
+    int64_t no_gain;  ///< pairs left out because the datacenter is as fast, with pruning
+    int64_t dominated;  ///< pairs left out because a roomy cache is faster, with pruning
+
+    SparseSavings(const CompactInstance<index_t>& ci, bool prune)
+            : begin(ci.V + 1, 0, ci.template allocator<uint32_t>()),
+              cache(ci.template allocator<index_t>()), save(ci.template allocator<save_t>()),
+              oversized(0), unreachable(0), no_gain(0), dominated(0) {
+        avector<index_t> connected(ci.template allocator<index_t>());
+        for (int v = 0; v < ci.V; ++v) {
+            begin[v + 1] = begin[v];
+            if (ci.video_size[v] > ci.X) {  // video ne gre v cache
+                oversized += ci.C;
+                continue;
+            }
+            connected.clear();
+            for (uint32_t k = ci.video_req_begin[v]; k < ci.video_req_begin[v+1]; ++k) {
+                index_t e = ci.req_endpoint[ci.video_req[k]];
+                for (uint32_t j = ci.ep_cache_begin[e]; j < ci.ep_cache_begin[e+1]; ++j) {
+                    index_t c = ci.ep_cache[j];
+                    connected.push_back(c);
+                    if (!prune || ci.lat(e, c) < ci.ep_dc_lat[e]) cache.push_back(c);
+                }
+            }
+            std::sort(connected.begin(), connected.end());
+            int64_t reachable = std::unique(connected.begin(), connected.end()) -
+                                connected.begin();
+            std::sort(cache.begin() + begin[v], cache.end());
+            cache.erase(std::unique(cache.begin() + begin[v], cache.end()), cache.end());
+            begin[v + 1] = cache.size();
+            unreachable += ci.C - reachable;
+            no_gain += reachable - (begin[v + 1] - begin[v]);
+        }
+        if (prune) remove_dominated(ci);
+        save.assign(cache.size(), 0);
+        for (int v = 0; v < ci.V; ++v) {
+            if (ci.video_size[v] > ci.X) continue;
+            for (uint32_t k = ci.video_req_begin[v]; k < ci.video_req_begin[v+1]; ++k) {
+                index_t rid = ci.video_req[k];
+                index_t e = ci.req_endpoint[rid];
+                for (uint32_t j = ci.ep_cache_begin[e]; j < ci.ep_cache_begin[e+1]; ++j) {
+                    index_t c = ci.ep_cache[j];
+                    if (prune && !has(c, v)) continue;
+                    at(c, v) += static_cast<save_t>(ci.req_num[rid]) *
+                                (ci.ep_dc_lat[e] - ci.lat(e, c));
+                }
+            }
+        }
+    }
+
+    /// Removes entries of caches dominated by a roomy cache, see above.
+    void remove_dominated(const CompactInstance<index_t>& ci) {
+        avector<int64_t> demand(ci.C, 0, ci.template allocator<int64_t>());
+        for (int v = 0; v < ci.V; ++v) {
+            for (uint32_t k = begin[v]; k < begin[v+1]; ++k) demand[cache[k]] += ci.video_size[v];
+        }
+        avector<index_t> roomy(ci.template allocator<index_t>());
+        uint32_t out = 0;
+        for (int v = 0; v < ci.V; ++v) {
+            uint32_t first = begin[v], last = begin[v+1];
+            begin[v] = out;
+            roomy.clear();
+            for (uint32_t k = first; k < last; ++k) {
+                if (demand[cache[k]] <= ci.X) roomy.push_back(cache[k]);
+            }
+            for (uint32_t k = first; k < last; ++k) {
+                index_t c = cache[k];
+                bool is_dominated = false;
+                for (index_t d : roomy) {
+                    if (d == c) continue;
+                    is_dominated = true;
+                    for (uint32_t r = ci.video_req_begin[v]; r < ci.video_req_begin[v+1]; ++r) {
+                        index_t e = ci.req_endpoint[ci.video_req[r]];
+                        int32_t lc = ci.lat(e, c), ld = ci.lat(e, d);
+                        if (lc < 0 || lc >= ci.ep_dc_lat[e]) continue;  // c saves nothing here
+                        if (ld < 0 || ld >= lc) {
+                            is_dominated = false;
+                            break;
+                        }
+                    }
+                    if (is_dominated) break;
+                }
+                if (is_dominated) {
+                    ++dominated;
+                } else {
+                    cache[out++] = c;
+                }
+            }
+        }
+        begin[ci.V] = out;
+        cache.resize(out);
+    }
+
+    /// True if there is an entry for video `v` on cache `c`.
+    bool has(int c, int v) const {
+        return std::binary_search(cache.begin() + begin[v], cache.begin() + begin[v+1], c);
+    }
+
+    /// Saving of video `v` on cache `c`, which must be connected to one of its endpoints.
+    save_t& at(int c, int v) {
+        return save[std::lower_bound(cache.begin() + begin[v], cache.begin() + begin[v+1], c) -
+                    cache.begin()];
+    }
+
+    /// Bytes held by the table.
+    size_t bytes() const { return mem_used(begin) + mem_used(cache) + mem_used(save); }
+};
+
+/**
+ * Recomputes savings of video `vid` for all caches, its best cache and the saving on it.
+ * Savings must be in video major layout, the column of the video is updated in place.
+ */
+template <typename index_t, typename save_t>
+void update_savings_for_video(const CompactInstance<index_t>& ci,
+                              SavingsMatrix<save_t>& savings, int vid,
+                              avector<index_t>& best_cache_for_video,
+                              avector<save_t>& best_save,
+                              const avector<avector<index_t>>& videos_per_cache) {
+    int C = ci.C;
+    save_t* column = savings.column(vid);
+    if (column[best_cache_for_video[vid]] != -2) {
+    for (int cid = 0; cid < C; ++cid) {
+        column[cid] = std::min<save_t>(column[cid], 0);
+    }
+    int32_t current_latency;
+    for (uint32_t k = ci.video_req_begin[vid]; k < ci.video_req_begin[vid+1]; ++k) {
+        index_t rid = ci.video_req[k];
+        index_t e = ci.req_endpoint[rid];
+        current_latency = ci.ep_dc_lat[e];
+        for (uint32_t j = ci.ep_cache_begin[e]; j < ci.ep_cache_begin[e+1]; ++j) {
+            index_t cid = ci.ep_cache[j];
+            // video is cached in cid (to be optimised)
+            if (std::find(videos_per_cache[cid].begin(), videos_per_cache[cid].end(), vid) !=
+                videos_per_cache[cid].end()) {
+                current_latency = std::min(current_latency, ci.lat(e, cid));
+            }
+        }
+
+        simd::accumulate_positive(column, &ci.ep_cache_lat[static_cast<size_t>(e) * C],
+                                  current_latency, ci.req_num[rid], C);
+    }}
+
+    int best = simd::argmax_first(column, C);
+    best_cache_for_video[vid] = best;
+    best_save[vid] = column[best];
+}
+
+/**
+ * Puts up to `batch` videos with the highest best saving into `candidates`, best first. Among
+ * equal savings videos with higher ids come first. Of the best `batch` videos only the first
+ * one for every cache is taken, the others are left for the next batch, so candidates of one
+ * batch touch disjoint caches. Their requests are disjoint anyway, as they are for different
+ * videos.
+ * @param order scratch space of size V
+ * @param cache_taken scratch space of size C, all zero before and after the call
+ */
+template <typename index_t, typename save_t>
+void get_best_videos_to_cache(const CompactInstance<index_t>& ci, const avector<save_t>& best_save,
+                              const avector<index_t>& best_cache_for_video, int batch,
+                              avector<index_t>& order, avector<char>& cache_taken,
+                              avector<index_t>& candidates) {
+    candidates.clear();
+    if (batch <= 1) {
+        candidates.push_back(simd::argmax_last(best_save.data(), ci.V));
+        return;
+    }
+    batch = std::min(batch, ci.V);
+    auto better = [&](index_t a, index_t b) {
+        return best_save[a] > best_save[b] || (best_save[a] == best_save[b] && a > b);
+    };
+    for (int v = 0; v < ci.V; ++v) order[v] = v;
+    std::nth_element(order.begin(), order.begin() + batch - 1, order.end(), better);
+    std::sort(order.begin(), order.begin() + batch, better);
+    for (int i = 0; i < batch; ++i) {
+        char& taken = cache_taken[best_cache_for_video[order[i]]];
+        if (taken) continue;
+        taken = 1;
+        candidates.push_back(order[i]);
+    }
+    for (index_t v : candidates) cache_taken[best_cache_for_video[v]] = 0;
+}
+
+/**
+ * Fills one cache with the best videos by `row` of savings. Videos with no saving are skipped,
+ * the rest are extracted from a heap only as long as something still fits.
+ * @param scratch buffer for candidates, reused between calls
+ * @param cached list the chosen videos are appended to
+ */
+template <typename index_t, typename save_t>
+void fill_cache(const CompactInstance<index_t>& ci, const save_t* row,
+                avector<std::tuple<save_t, int, index_t>>& scratch, avector<index_t>& cached) {
+    int X = ci.X;
+    // only videos with some saving are worth caching
+    scratch.clear();
+    int min_size = X + 1;
+    for (int v = 0; v < ci.V; ++v) {
+        if (row[v] <= 0) continue;
+        scratch.push_back(std::make_tuple(row[v], ci.video_size[v], static_cast<index_t>(v)));
+        min_size = std::min(min_size, ci.video_size[v]);
+    }
+    // extract candidates best first, only as many as needed to fill the cache
+    std::make_heap(scratch.begin(), scratch.end());
+    auto end = scratch.end();
+    int space = X;
+    save_t save;
+    int size;
+    index_t vid;
+    while (space >= min_size && end != scratch.begin()) {
+        std::pop_heap(scratch.begin(), end);
+        --end;
+        std::tie(save, size, vid) = *end;
+        if (size <= space) {
+            cached.push_back(vid);
+            space -= size;
+        }
+    }
+}
+
+/// Bytes held by the list of videos for every cache and free space of every cache.
+template <typename index_t>
+size_t placement_bytes(const avector<avector<index_t>>& videos_per_cache,
+                       const avector<int>* space_left = nullptr) {
+    return nested_mem_used(videos_per_cache) + (space_left ? mem_used(*space_left) : 0);
+}
+
+/**
+ * Kernel of greedy1, see dispatch(). If the dense savings table does not fit in `max_memory`,
+ * every thread computes savings of the cache it fills into one row instead.
+ */
+struct Greedy1Kernel {
+    size_t max_memory;  ///< limit on the dense savings table, 0 for none
+
+    template <typename index_t, typename save_t>
+    std::vector<std::vector<int>> run(const CompactInstance<index_t>& ci) const {
+        typedef std::tuple<save_t, int, index_t> entry_t;
+        int C = ci.C, V = ci.V;
+        bool dense = dense_fits<save_t>(C, V, max_memory);
+
+        // every thread fills caches into its own arena and reuses one tuple buffer
+        int threads = std::max(1, omp_get_max_threads());
+        avector<avector<entry_t>> scratch = empty_rows<entry_t>(ci, threads);
+        std::vector<std::unique_ptr<Arena>> thread_arenas;
+        size_t scratch_bytes = 0;
+        for (int t = 0; t < threads; ++t) {
+            scratch[t].reserve(V);
+            scratch_bytes += mem_reserved(scratch[t]);
+            thread_arenas.push_back(make_unique<Arena>());
+        }
+        avector<avector<index_t>> videos_per_cache = empty_rows<index_t>(ci, C);
+
+        if (dense) {
+            // every cache is filled from one contiguous row
+            SavingsMatrix<save_t> savings =
+                    calc_savings<index_t, save_t>(ci, SavingsLayout::cache_major);
+            report_memory("greedy1 savings", {{"instance tables", ci.bytes()},
+                                              {"savings matrix", savings.bytes()},
+                                              {"candidate index", scratch_bytes}});
+            parallel_for_stealing(C, [&](int c, int t) {
+                avector<index_t>& cached = videos_per_cache[c];
+                cached = avector<index_t>(ArenaAllocator<index_t>(thread_arenas[t].get()));
+                fill_cache(ci, savings.row(c), scratch[t], cached);
+            });
+        } else {
+            CacheIndex<index_t> index(ci);
+            avector<avector<save_t>> rows = empty_rows<save_t>(ci, threads);
+            for (int t = 0; t < threads; ++t) rows[t].resize(V);
+            report_memory("greedy1 savings", {{"instance tables", ci.bytes() + index.bytes()},
+                                              {"savings rows", nested_mem_used(rows)},
+                                              {"candidate index", scratch_bytes}});
+            parallel_for_stealing(C, [&](int c, int t) {
+                avector<index_t>& cached = videos_per_cache[c];
+                cached = avector<index_t>(ArenaAllocator<index_t>(thread_arenas[t].get()));
+                calc_cache_savings<index_t, save_t>(ci, index, c, nullptr, rows[t].data());
+                fill_cache(ci, rows[t].data(), scratch[t], cached);
+            });
+        }
+        report_memory("greedy1 placement",
+                      {{"placement index", placement_bytes(videos_per_cache)}});
+        return to_int(videos_per_cache);
+    }
+};
+
+/**
+ * Kernel of conflict aware greedy1, see dispatch(). Caches are filled from rows of the savings
+ * table and decreases touch the column of a video on nearby caches, so the table is tiled. If
+ * it does not fit in `max_memory`, the row of every cache is computed from current latencies
+ * just before the cache is filled, which gives the same savings as decreasing the table.
+ */
+struct Greedy1ConflictKernel {
+    size_t max_memory;  ///< limit on the dense savings table, 0 for none
+
+    template <typename index_t, typename save_t>
+    std::vector<std::vector<int>> run(const CompactInstance<index_t>& ci) const {
+        typedef std::tuple<save_t, int, index_t> entry_t;
+        int C = ci.C, V = ci.V, R = ci.R;
+        bool dense = dense_fits<save_t>(C, V, max_memory);
+        SavingsMatrix<save_t> savings =
+                dense ? calc_savings<index_t, save_t>(ci, SavingsLayout::tiled)
+                      : SavingsMatrix<save_t>(0, 0, SavingsLayout::tiled,
+                                              ci.template allocator<save_t>());
+        std::unique_ptr<CacheIndex<index_t>> index;
+        if (!dense) index.reset(new CacheIndex<index_t>(ci));
+        avector<save_t> row(V, 0, ci.template allocator<save_t>());
+        avector<entry_t> scratch(ci.template allocator<entry_t>());
+        scratch.reserve(V);
+        avector<avector<index_t>> videos_per_cache = empty_rows<index_t>(ci, C);
+        // latency every request currently gets with caches filled so far
+        avector<int32_t> current_latency(R, 0, ci.template allocator<int32_t>());
+        for (int r = 0; r < R; ++r) current_latency[r] = ci.ep_dc_lat[ci.req_endpoint[r]];
+        report_memory("greedy1-conflict savings",
+                      {{"instance tables", ci.bytes() + (index ? index->bytes() : 0)},
+                       {"savings matrix", savings.bytes() + mem_used(row)},
+                       {"candidate index", mem_reserved(scratch)},
+                       {"placement index", mem_used(current_latency)}});
+
+        for (int c = 0; c < C; ++c) {
+            if (dense) {
+                savings.copy_row(c, row.data());
+            } else {
+                calc_cache_savings<index_t, save_t>(ci, *index, c, current_latency.data(),
+                                                    row.data());
+            }
+            fill_cache(ci, row.data(), scratch, videos_per_cache[c]);
+            // requests served better by cache c now save less on caches not filled yet
+            for (index_t v : videos_per_cache[c]) {
+                for (uint32_t k = ci.video_req_begin[v]; k < ci.video_req_begin[v+1]; ++k) {
+                    index_t rid = ci.video_req[k];
+                    index_t e = ci.req_endpoint[rid];
+                    int32_t old_lat = current_latency[rid], new_lat = ci.lat(e, c);
+                    if (new_lat < 0 || new_lat >= old_lat) continue;
+                    current_latency[rid] = new_lat;
+                    if (!dense) continue;  // rows are computed from current_latency
+                    for (uint32_t j = ci.ep_cache_begin[e]; j < ci.ep_cache_begin[e+1]; ++j) {
+                        index_t other = ci.ep_cache[j];
+                        if (static_cast<int>(other) <= c) continue;
+                        int32_t lat = ci.lat(e, other);
+                        savings(other, v) -= static_cast<save_t>(ci.req_num[rid]) *
+                                (std::max(0, old_lat - lat) - std::max(0, new_lat - lat));
+                    }
+                }
+            }
+        }
+        report_memory("greedy1-conflict placement",
+                      {{"placement index",
+                        placement_bytes(videos_per_cache) + mem_used(current_latency)}});
+        return to_int(videos_per_cache);
+    }
+};
+
+/**
+ * Kernel of greedy2, see dispatch(). With `batch` > 1 the best `batch` candidates, one per
+ * video and cache, are committed together in order; candidates sharing a cache with a better
+ * one are deferred to the next batch, see get_best_videos_to_cache(). A candidate that does not
+ * fit its cache is marked and its video competes with its next best cache in the next batch.
+ * The savings of all touched videos are then updated in parallel. Updates of different videos
+ * touch disjoint columns of the savings table and only read cache contents, which do not change
+ * during the update.
+ *
+ * If the dense savings table does not fit in `max_memory`, SparseSavings are used instead.
+ * Placements with positive saving are the same. Videos left with zero saving, e.g. already
+ * placed ones, fill remaining space only on caches connected to endpoints requesting them,
+ * instead of on any cache.
+ */
+struct Greedy2Kernel {
+    int batch;  ///< number of placements committed per iteration
+    size_t max_memory;  ///< limit on the dense savings table, 0 for none
+    bool prune;  ///< run on pruned SparseSavings even if the dense table fits
+
+    template <typename index_t, typename save_t>
+    std::vector<std::vector<int>> run(const CompactInstance<index_t>& ci) const {
+        if (prune || !dense_fits<save_t>(ci.C, ci.V, max_memory)) {
+            return run_sparse<index_t, save_t>(ci);
+        }
+        int C = ci.C, V = ci.V, X = ci.X;
+        // all later scans and updates walk the savings of one video over all caches
+        SavingsMatrix<save_t> savings =
+                calc_savings<index_t, save_t>(ci, SavingsLayout::video_major);
+        avector<avector<index_t>> videos_per_cache = empty_rows<index_t>(ci, C);
+        avector<int> cache_space_left(C, X, ci.template allocator<int>());
+        int64_t done = 0, report = 10000;
+        int64_t all = static_cast<int64_t>(C)*V;
+        avector<index_t> best_cache_for_video(V, 0, ci.template allocator<index_t>());
+        avector<save_t> best_save(V, 0, ci.template allocator<save_t>());
+        avector<index_t> order(V, 0, ci.template allocator<index_t>());
+        avector<char> cache_taken(C, 0, ci.template allocator<char>());
+        avector<index_t> candidates(ci.template allocator<index_t>());
+        avector<index_t> touched(ci.template allocator<index_t>());
+        for (int v = 0; v < V; ++v) {
+            const save_t* column = savings.column(v);
+            best_cache_for_video[v] = simd::argmax_first(column, C);
+            best_save[v] = column[best_cache_for_video[v]];
+        }
+        size_t candidate_bytes = mem_used(best_cache_for_video) + mem_used(best_save) +
+                                 mem_used(order);
+        report_memory("greedy2 savings", {{"instance tables", ci.bytes()},
+                                          {"savings matrix", savings.bytes()},
+                                          {"candidate index", candidate_bytes}});
+
+        while (true) {
+            get_best_videos_to_cache(ci, best_save, best_cache_for_video, batch, order,
+                                     cache_taken, candidates);
+            touched.clear();
+            for (index_t best_video : candidates) {
+                int best_cache = best_cache_for_video[best_video];
+                if (savings(best_cache, best_video) < 0) break;
+                touched.push_back(best_video);
+                done += 1;
+                if (cache_space_left[best_cache] < ci.video_size[best_video]) {  // no space
+                    savings(best_cache, best_video) = -2;  // cant, retry on next best cache
+                    best_save[best_video] = -2;
+                    continue;
+                }
+                cache_space_left[best_cache] -= ci.video_size[best_video];
+                videos_per_cache[best_cache].push_back(best_video);
+                savings(best_cache, best_video) = -1;
+                best_save[best_video] = -1;
+            }
+            if (touched.empty()) break;
+
+            if (done >= report) {
+                std::cerr << done << "/" << all << " = " << (double) done / all *100 << "% \n";
+                report += 10000;
+            }
+
+            int n = touched.size();
+            #pragma omp parallel for schedule(dynamic, 1) if (n > 1)
+            for (int i = 0; i < n; ++i) {
+                update_savings_for_video(ci, savings, touched[i], best_cache_for_video,
+                                         best_save, videos_per_cache);
+            }
+        }
+        report_memory("greedy2 placement",
+                      {{"placement index", placement_bytes(videos_per_cache, &cache_space_left)}});
+        return to_int(videos_per_cache);
+    }
+
+    /// Same as run() on SparseSavings.
+    template <typename index_t, typename save_t>
+    std::vector<std::vector<int>> run_sparse(const CompactInstance<index_t>& ci) const {
+        int C = ci.C, V = ci.V, X = ci.X;
+        SparseSavings<index_t, save_t> savings(ci, prune);
+        if (prune) {
+            int64_t pruned = savings.oversized + savings.unreachable + savings.no_gain +
+                             savings.dominated;
+            std::cerr << "Pruned " << pruned << " of " << static_cast<int64_t>(C) * V
+                      << " (cache, video) pairs: " << savings.oversized << " with oversized "
+                      << "videos, " << savings.unreachable << " unreachable, "
+                      << savings.no_gain << " no faster than the datacenter, "
+                      << savings.dominated << " dominated by a roomy cache." << std::endl;
+        }
+        avector<avector<index_t>> videos_per_cache = empty_rows<index_t>(ci, C);
+        avector<int> cache_space_left(C, X, ci.template allocator<int>());
+        avector<index_t> best_cache_for_video(V, 0, ci.template allocator<index_t>());
+        avector<save_t> best_save(V, 0, ci.template allocator<save_t>());
+        avector<index_t> order(V, 0, ci.template allocator<index_t>());
+        avector<char> cache_taken(C, 0, ci.template allocator<char>());
+        avector<index_t> candidates(ci.template allocator<index_t>());
+        avector<index_t> touched(ci.template allocator<index_t>());
+        // first cache with the highest saving, videos without entries are never cached
+        auto update_best = [&](int v) {
+            best_cache_for_video[v] = 0;
+            best_save[v] = -1;
+            for (uint32_t k = savings.begin[v]; k < savings.begin[v+1]; ++k) {
+                if (k == savings.begin[v] || savings.save[k] > best_save[v]) {
+                    best_save[v] = savings.save[k];
+                    best_cache_for_video[v] = savings.cache[k];
+                }
+            }
+        };
+        for (int v = 0; v < V; ++v) update_best(v);
+        size_t candidate_bytes = mem_used(best_cache_for_video) + mem_used(best_save) +
+                                 mem_used(order);
+        report_memory("greedy2 sparse savings", {{"instance tables", ci.bytes()},
+                                                 {"savings matrix", savings.bytes()},
+                                                 {"candidate index", candidate_bytes}});
+
+        while (true) {
+            get_best_videos_to_cache(ci, best_save, best_cache_for_video, batch, order,
+                                     cache_taken, candidates);
+            touched.clear();
+            for (index_t best_video : candidates) {
+                if (best_save[best_video] < 0) break;
+                int best_cache = best_cache_for_video[best_video];
+                touched.push_back(best_video);
+                if (cache_space_left[best_cache] < ci.video_size[best_video]) {  // no space
+                    savings.at(best_cache, best_video) = -2;  // retry on next best cache
+                    continue;
+                }
+                cache_space_left[best_cache] -= ci.video_size[best_video];
+                videos_per_cache[best_cache].push_back(best_video);
+                savings.at(best_cache, best_video) = -1;
+            }
+            if (touched.empty()) break;
+
+            // placed videos save nothing more, as in update_savings_for_video()
+            int n = touched.size();
+            #pragma omp parallel for schedule(dynamic, 1) if (n > 1)
+            for (int i = 0; i < n; ++i) {
+                int v = touched[i];
+                if (savings.at(best_cache_for_video[v], v) != -2) {
+                    for (uint32_t k = savings.begin[v]; k < savings.begin[v+1]; ++k) {
+                        savings.save[k] = std::min<save_t>(savings.save[k], 0);
+                    }
+                }
+                update_best(v);
+            }
+        }
+        report_memory("greedy2 sparse placement",
+                      {{"placement index", placement_bytes(videos_per_cache, &cache_space_left)}});
+        return to_int(videos_per_cache);
+    }
+};
+
+}  // namespace
+
+std::vector<std::vector<int>> greedy1(const Instance& inst, size_t max_memory) {
+    if (inst.C == 0 || inst.V == 0) return std::vector<std::vector<int>>(inst.C);
+    return dispatch(inst, Greedy1Kernel{max_memory});
+}
+
+std::vector<std::vector<int>> greedy1_conflict_aware(const Instance& inst, size_t max_memory) {
+    if (inst.C == 0 || inst.V == 0) return std::vector<std::vector<int>>(inst.C);
+    return dispatch(inst, Greedy1ConflictKernel{max_memory});
+}
+
+std::vector<std::vector<int>> greedy2(const Instance& inst, int batch, size_t max_memory,
+                                      bool prune) {
+    if (inst.C == 0 || inst.V == 0) return std::vector<std::vector<int>>(inst.C);
+    return dispatch(inst, Greedy2Kernel{batch, max_memory, prune});
+}
+
+solver_t solver_by_name(const std::string& name, size_t max_memory) {
+    if (name == "greedy1") {
+        return [max_memory](const Instance& inst) { return greedy1(inst, max_memory); };
+    }
+    if (name == "greedy1-conflict") {
+        return [max_memory](const Instance& inst) {
+            return greedy1_conflict_aware(inst, max_memory);
+        };
+    }
+    if (name == "greedy2") {
+        return [max_memory](const Instance& inst) { return greedy2(inst, 1, max_memory); };
+    }
+    return nullptr;
+}
+
+}  // namespace mm
@@ -0,0 +1,64 @@
+#ifndef SRC_GREEDY_HPP_
+#define SRC_GREEDY_HPP_
+
+/**
+ * @file
+ * @brief Greedy solvers working on a single Instance. They keep no global state, so different
+ * instances can be solved concurrently. Internally every solver runs on the narrowest
+ * CompactInstance the instance fits in, see dispatch().
+ */
+
+#include "instance.hpp"
+
+namespace mm {
+
+/**
+ * Fills every cache independently with videos sorted by their saving for that cache, computed
+ * once upfront.
+ * @param max_memory Limit in bytes on the dense table of savings of all (cache, video) pairs,
+ * 0 for none. Above it savings of every cache are computed just before it is filled.
+ * @return List of cached videos for every cache.
+ */
+std::vector<std::vector<int>> greedy1(const Instance& inst, size_t max_memory = 0);
+
+/**
+ * Like greedy1, but fills caches one after another. After a cache is filled, savings of its
+ * videos on caches not yet filled are decreased by the latency the cache already saves, so the
+ * same popular video is not stored on every cache an endpoint can reach.
+ * @param max_memory Limit on the dense savings table as in greedy1.
+ * @return List of cached videos for every cache.
+ */
+std::vector<std::vector<int>> greedy1_conflict_aware(const Instance& inst, size_t max_memory = 0);
+
+/**
+ * Repeatedly caches the (cache, video) pair with the highest saving and recomputes the
+ * savings of the placed video for all caches.
+ * @param batch Number of best pairs considered at once. Of them, at most one per video and one
+ * per cache is committed before their savings are recomputed in parallel, the others are
+ * deferred to the next batch, as are pairs that do not fit, so results stay close to the
+ * one-at-a-time greedy. Pairs of different videos serve disjoint requests and savings of a
+ * video depend only on its own requests, so endpoints shared between pairs need no check.
+ * @param max_memory Limit in bytes on the dense savings table, 0 for none. Above it savings are
+ * stored only for caches connected to endpoints requesting the video, so videos with zero
+ * saving fill remaining space only there.
+ * @param prune Use the sparse savings also when the dense table fits, and leave out caches
+ * that are no faster than the datacenter for any requesting endpoint, or that another cache
+ * with room for all its candidate videos beats for every endpoint they serve. Reports the
+ * number of pruned pairs to stderr.
+ * @return List of cached videos for every cache.
+ */
+std::vector<std::vector<int>> greedy2(const Instance& inst, int batch = 1, size_t max_memory = 0,
+                                      bool prune = false);
+
+/// Type of solvers taking an instance and returning list of cached videos for every cache.
+typedef std::function<std::vector<std::vector<int>>(const Instance&)> solver_t;
+
+/**
+ * Solver with given name (greedy1, greedy1-conflict or greedy2) and default parameters, empty if
+ * there is none. `max_memory` is passed to the solver.
+ */
+solver_t solver_by_name(const std::string& name, size_t max_memory = 0);
+
+}  // namespace mm
+
+#endif  // SRC_GREEDY_HPP_
@@ -2,198 +2,54 @@
 #include <vector>
 #include "includes.hpp"
 #include "common.hpp"
-#include <functional>
+#include "instance.hpp"
+#include "greedy.hpp"
+#include "decompose.hpp"
+#include "reorder.hpp"
+#include "compress.hpp"
+#include "polish.hpp"
+#include "driver.hpp"
+#include "memory.hpp"
 
 using namespace mm;
 using namespace std;
 
-#define MAXC 1001
-
-int V, E, R, C, X;
-
-struct Endpoint {
-    int datacenter_lat;
-    vector<int> connected_caches;
-    vector<int> cache_lat;
-    int num_connected_caches;
-
-    Endpoint(int dl, const vector<int>& cc, const vector<int>& cl) {
-        num_connected_caches = cc.size();
-        datacenter_lat = dl;
-        connected_caches = cc;
-        cache_lat.resize(MAXC, -1);
-        for (int i = 0; i < cl.size(); ++i) {
-            cache_lat[connected_caches[i]] = cl[i];
-        }
-    }
-};
-
-struct Request {
-    int video_id, endpoint_id, num_req;
-};
-
-struct Video {
-    int size;
-    vector<int> request_ids;
-};
-
-vector<Video> videos;
-vector<Request> requests;
-vector<Endpoint> endpoints;
-vector<vector<int>> videos_per_cache;
-
-ostream& operator<<(ostream& os, Request r) {
-    cout << "Request(v=" << r.video_id << ", e=" << r.endpoint_id << ", n=" << r.num_req << ")";
-    return cout;
-}
-
-ostream& operator<<(ostream& os, Endpoint e) {
-    cout << "Endpoint with " << e.num_connected_caches << " caches and " << e.datacenter_lat << " latency.";
-    return cout;
+int main(int argc, char* argv[]) {
+    Options opt(argc, argv);
+    int batch = opt.get_int("batch", 1);
+    enable_memory_report(opt.has("memory-report"));
+    size_t max_memory = parse_bytes(opt.get("max-memory", "0"));
+    Instance inst = read_instance(cin);
+    report_memory("load", {{"instance", inst.arena->used()}});
+    bool prune = opt.has("prune");
+    solver_t component_solver = [batch, max_memory, prune](const Instance& sub) {
+        return greedy2(sub, batch, max_memory, prune);
+    };
+    if (opt.has("reorder")) {
+        component_solver = [component_solver](const Instance& sub) {
+            return solve_reordered(sub, component_solver);
+        };
+    }
+    solver_t solver = [component_solver](const Instance& inst) {
+        return solve_by_components(inst, component_solver);
+    };
+    if (opt.has("compress")) {
+        solver = [solver](const Instance& inst) { return solve_compressed(inst, solver); };
+    }
+    if (opt.has("polish")) {
+        PolishParams params;
+        params.caches = opt.get_int("polish", params.caches);
+        params.node_limit = opt.get_int("polish-nodes", params.node_limit);
+        params.time_limit = opt.get_double("polish-time", params.time_limit);
+        solver = [solver, params](const Instance& inst) {
+            Placement p(inst, solver(inst));
+            polish(p, params);
+            return p.videos_per_cache();
+        };
+    }
+    bool ok;
+    vector<vector<int>> videos_per_cache =
+            solve_verified(solver, inst, opt.get_int("verify-determinism", 1), ok);
+    write_solution(cout, videos_per_cache);
+    return ok ? 0 : 2;
 }
-
-vector<vector<int>> calc_savings() {
-    vector<vector<int>> savings(C, vector<int>(V, 0));
-    for (int c = 0; c < C; ++c) {
-        for (int v = 0; v < V; ++v) {
-            Video& vid = videos[v];
-            if (vid.size <= X) {  // video gre v cache
-                for (int rid : vid.request_ids) {  // requesti, ki zelijo ta video
-                    Request& r = requests[rid];
-                    if (endpoints[r.endpoint_id].cache_lat[c] >= 0)  // smo povezani z cachem c
-                        savings[c][v] += r.num_req * (endpoints[r.endpoint_id].datacenter_lat -
-                                                      endpoints[r.endpoint_id].cache_lat[c]);
-                }
-            }
-        }
-    }
-    return savings;
-}
-
-void update_savings_for_video(vector<vector<int>>& savings, int vid, vector<int>& best_cache_for_video) {
-    if (savings[best_cache_for_video[vid]][vid] != -2) {
-    for (int cid = 0; cid < C; ++cid) {
-        if (savings[cid][vid] > 0) {
-            savings[cid][vid] = 0;
-        }
-    }
-    Video& v = videos[vid];
-    int current_latency;
-    for (int rid : v.request_ids) {
-        auto& r = requests[rid];
-        auto& e = endpoints[r.endpoint_id];
-        current_latency = e.datacenter_lat;
-        for (int cid : e.connected_caches) {
-            // video is cached in cid (to be optimised)
-            if (find(videos_per_cache[cid].begin(), videos_per_cache[cid].end(), vid) != videos_per_cache[cid].end()) {
-                current_latency = min(current_latency, e.cache_lat[cid]);
-            }
-        }
-
-        for (int cid = 0; cid < C; ++cid) {
-            if (savings[cid][vid] > 0) {
-                savings[cid][vid] += max(0, current_latency - e.cache_lat[cid]) * r.num_req;
-            }
-        }
-    }}
-
-    int save = -10;
-    for (int c = 0; c < C; ++c) {
-        if (savings[c][vid] > save) {
-            save = savings[c][vid];
-            best_cache_for_video[vid] = c;
-        }
-    }
-}
-
-pair<int, int> get_best_video_to_cache(const vector<vector<int>>& savings, const vector<int>& best_cache_for_video) {
-    int best_cache, best_video, best_save = -10;
-//    for (int c = 0; c < C; ++c) {
-        for (int v = 0; v < V; ++v) {
-            int bc = best_cache_for_video[v];
-            if (savings[bc][v] >= best_save) {
-                best_save = savings[bc][v];
-                best_cache = bc;
-                best_video = v;
-            }
-        }
-//    }
-    return {best_cache, best_video};
-}
-
-int main() {
-    cin >> V >> E >> R >> C >> X;
-    videos.resize(V);
-    int datacenter_latency, num_caches;
-    for (int i = 0; i < V; ++i) {
-        cin >> videos[i].size;
-    }
-    for (int e = 0; e < E; ++e) {
-        cin >> datacenter_latency >> num_caches;
-        vector<int> cc(num_caches), cl(num_caches);
-        for (int i = 0; i < num_caches; ++i) {
-            cin >> cc[i] >> cl[i];
-        }
-        endpoints.push_back(Endpoint(datacenter_latency, cc, cl));
-    }
-
-    requests.resize(R);
-    int vid, eid, nr;
-    for (int i = 0; i < R; ++i) {
-        cin >> vid >> eid >> nr;
-        requests[i] = {vid, eid, nr};
-        videos[vid].request_ids.push_back(i);
-    }
-
-//    prn("here");
-    vector<vector<int>> savings = calc_savings();
-    int best_cache, best_video;
-    videos_per_cache.resize(C);
-    vector<int> cache_space_left(C, X);
-    int done = 0;
-    int all = C*V;
-    vector<int> best_cache_for_video(V, 0);
-    for (int v = 0; v < V; ++v) {
-        int save = savings[best_cache_for_video[v]][v];
-        for (int c = 0; c < C; ++c) {
-            if (savings[c][v] > save) {
-                save = savings[c][v];
-                best_cache_for_video[v] = c;
-            }
-        }
-    }
-
-    while (true) {
-        tie(best_cache, best_video) = get_best_video_to_cache(savings, best_cache_for_video);
-//        prn(best_cache);
-//        prn(best_video);
-//        prn(savings[best_cache][best_video]);
-        if (savings[best_cache][best_video] < 0) break;
-        if (cache_space_left[best_cache] < videos[best_video].size) {  // no space
-            savings[best_cache][best_video] = -2;  // cant
-        } else {
-            cache_space_left[best_cache] -= videos[best_video].size;
-            videos_per_cache[best_cache].push_back(best_video);
-            savings[best_cache][best_video] = -1;
-        }
-
-        done += 1;
-        if (done % 10000 == 0) {
-            cerr << done << "/" << all << " = " << (double) done / all *100 << "% \n";
-        }
-
-        update_savings_for_video(savings, best_video, best_cache_for_video);
-//        prn(best_cache_for_video);
-    }
-
-    cout << C << endl;
-    for (int c = 0; c < C; ++c) {
-        cout << c;
-        for (int v : videos_per_cache[c]) {
-            cout << " " << v;
-        }
-        cout << endl;
-    }
-
-    return 0;
-}
\ No newline at end of file
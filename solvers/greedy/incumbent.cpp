@@ -0,0 +1,57 @@
+/**
+ * @file
+ * @brief Implementation of the shared best solution declared in incumbent.hpp.
+ */
+
+#include "incumbent.hpp"
+
+namespace mm {
+
+Incumbent::Incumbent() : best_(nullptr), retired_(nullptr) {}
+
+Incumbent::~Incumbent() {
+    reclaim();
+    delete best_.load();
+}
+
+bool Incumbent::offer(int64_t saved, const std::vector<std::vector<int>>& videos_per_cache) {
+    Snapshot* current = best_.load(std::memory_order_acquire);
+    if (current && current->saved >= saved) return false;  // cheap check before copying
+    Snapshot* candidate = new Snapshot(saved, videos_per_cache);
+    do {
+        if (current && current->saved >= saved) {
+            delete candidate;
+            return false;
+        }
+    } while (!best_.compare_exchange_weak(current, candidate, std::memory_order_acq_rel,
+                                          std::memory_order_acquire));
+    if (current) {
+        current->next_retired_ = retired_.load(std::memory_order_relaxed);
+        while (!retired_.compare_exchange_weak(current->next_retired_, current,
+                                               std::memory_order_release,
+                                               std::memory_order_relaxed)) {}
+    }
+    return true;
+}
+
+int64_t Incumbent::best_saved() const {
+    const Snapshot* current = best();
+    return current ? current->saved : -1;
+}
+
+bool Incumbent::write(const std::string& path, int C) const {
+    const Snapshot* current = best();
+    if (!current) return write_solution_atomic(path, std::vector<std::vector<int>>(C));
+    return write_solution_atomic(path, current->videos_per_cache);
+}
+
+void Incumbent::reclaim() {
+    Snapshot* s = retired_.exchange(nullptr, std::memory_order_acquire);
+    while (s) {
+        Snapshot* next = s->next_retired_;
+        delete s;
+        s = next;
+    }
+}
+
+}  // namespace mm
@@ -0,0 +1,77 @@
+#ifndef SRC_INCUMBENT_HPP_
+#define SRC_INCUMBENT_HPP_
+
+/**
+ * @file
+ * @brief Best solution shared between threads of a search without locks. Workers publish
+ * improvements with one compare-and-swap of a pointer to an immutable snapshot and read the
+ * current best with one atomic load, so no thread ever waits for another.
+ */
+
+#include "instance.hpp"
+
+namespace mm {
+
+/// Immutable solution published in an Incumbent.
+class Snapshot {
+  public:
+    const int64_t saved;  ///< saved latency, larger is better
+    const std::vector<std::vector<int>> videos_per_cache;
+
+    Snapshot(int64_t saved_, const std::vector<std::vector<int>>& videos_per_cache_)
+            : saved(saved_), videos_per_cache(videos_per_cache_), next_retired_(nullptr) {}
+
+  private:
+    friend class Incumbent;
+    Snapshot* next_retired_;  ///< next snapshot on the retired list
+};
+
+/**
+ * Best solution offered so far. Replaced snapshots are not freed at once but put on a retired
+ * list, since other threads may still read them; they are freed by reclaim() or on destruction.
+ * Memory thus grows with the number of improvements, which is small for improvement searches.
+ */
+class Incumbent {
+  public:
+    /// Store with no solution yet.
+    Incumbent();
+    ~Incumbent();
+    Incumbent(const Incumbent&) = delete;
+    Incumbent& operator=(const Incumbent&) = delete;
+
+    /**
+     * Publishes the solution if it saves strictly more than the current best. Safe to call from
+     * any number of threads at once.
+     * @return True if the solution became the best one.
+     */
+    bool offer(int64_t saved, const std::vector<std::vector<int>>& videos_per_cache);
+
+    /**
+     * Current best, null if nothing was offered yet. The snapshot stays valid until reclaim() or
+     * destruction of the store, even if it is replaced meanwhile.
+     */
+    const Snapshot* best() const { return best_.load(std::memory_order_acquire); }
+    /// Saved latency of the current best, -1 if nothing was offered yet.
+    int64_t best_saved() const;
+
+    /**
+     * Writes the current best to `path` with write_solution_atomic(), an empty solution with
+     * `C` caches if there is none.
+     * @return False if the file could not be written.
+     */
+    bool write(const std::string& path, int C) const;
+
+    /**
+     * Frees replaced snapshots. No other thread may use this store meanwhile, nor hold
+     * snapshots other than the current best.
+     */
+    void reclaim();
+
+  private:
+    std::atomic<Snapshot*> best_;
+    std::atomic<Snapshot*> retired_;  ///< head of the list of replaced snapshots
+};
+
+}  // namespace mm
+
+#endif  // SRC_INCUMBENT_HPP_
@@ -0,0 +1,152 @@
+/**
+ * @file
+ * @brief Implementation of instance reading and solution writing declared in instance.hpp.
+ */
+
+#include "instance.hpp"
+
+namespace mm {
+
+Endpoint::Endpoint(int dl, int C, const ArenaAllocator<int>& alloc)
+        : datacenter_lat(dl), connected_caches(alloc), cache_lat(C, -1, alloc),
+          num_connected_caches(0) {}
+
+void Endpoint::connect(int c, int lat) {
+    connected_caches.push_back(c);
+    cache_lat[c] = lat;
+    num_connected_caches = connected_caches.size();
+}
+
+Instance::Instance() : V(0), E(0), R(0), C(0), X(0) {}
+
+Instance::Instance(int V_, int E_, int R_, int C_, int X_)
+        : V(V_), E(E_), R(R_), C(C_), X(X_),
+          arena(std::make_shared<Arena>(instance_bytes(V_, E_, R_, C_))),
+          videos(allocator<Video>()), endpoints(allocator<Endpoint>()),
+          requests(allocator<Request>()) {
+    videos.reserve(V);
+    endpoints.reserve(E);
+    requests.reserve(R);
+}
+
+size_t instance_bytes(int V, int E, int R, int C) {
+    size_t bytes = V * sizeof(Video) + E * sizeof(Endpoint) + R * sizeof(Request);
+    bytes += R * sizeof(int);  // request ids of videos
+    bytes += 2 * static_cast<size_t>(E) * C * sizeof(int);  // connections and latencies
+    return bytes + 16 * (V + 2 * E) + 4096;  // alignment
+}
+
+Instance read_instance(std::istream& is) {
+    int V, E, R, C, X;
+    is >> V >> E >> R >> C >> X;
+    if (!is || V < 0 || E < 0 || R < 0 || C < 0 || X < 0) {
+        is.setstate(std::ios::failbit);
+        return Instance(0, 0, 0, 0, 0);
+    }
+    Instance inst(V, E, R, C, X);
+    int size;
+    for (int i = 0; i < V; ++i) {
+        is >> size;
+        inst.videos.emplace_back(size, inst.allocator<int>());
+    }
+    int datacenter_latency, num_caches, cid, lat;
+    for (int e = 0; e < E; ++e) {
+        is >> datacenter_latency >> num_caches;
+        inst.endpoints.emplace_back(datacenter_latency, C, inst.allocator<int>());
+        Endpoint& ep = inst.endpoints.back();
+        ep.connected_caches.reserve(num_caches);
+        for (int i = 0; i < num_caches; ++i) {
+            is >> cid >> lat;
+            ep.connect(cid, lat);
+        }
+    }
+
+    inst.requests.resize(R);
+    std::vector<int> count(V, 0);
+    int vid, eid, nr;
+    for (int i = 0; i < R; ++i) {
+        is >> vid >> eid >> nr;
+        inst.requests[i] = {vid, eid, nr};
+        count[vid]++;
+    }
+    for (int v = 0; v < V; ++v) inst.videos[v].request_ids.reserve(count[v]);
+    for (int i = 0; i < R; ++i) {
+        inst.videos[inst.requests[i].video_id].request_ids.push_back(i);
+    }
+    return inst;
+}
+
+std::vector<std::vector<int>> read_solution(std::istream& is, int C, std::string* error) {
+    auto fail = [error](const std::string& problem) {
+        if (error) *error = problem;
+        return std::vector<std::vector<int>>();
+    };
+    std::vector<std::vector<int>> videos_per_cache(C);
+    std::vector<char> listed(C, 0);
+    int n;
+    if (!(is >> n) || n < 0 || n > C) return fail("invalid number of caches");
+    std::string line;
+    std::getline(is, line);
+    for (int i = 0; i < n; ++i) {
+        if (!std::getline(is, line)) return fail("missing cache descriptions");
+        std::istringstream ls(line);
+        int c, v;
+        if (!(ls >> c) || c < 0 || c >= C) return fail("invalid cache id");
+        if (listed[c]) return fail("cache " + std::to_string(c) + " listed more than once");
+        listed[c] = 1;
+        while (ls >> v) videos_per_cache[c].push_back(v);
+    }
+    return videos_per_cache;
+}
+
+void write_solution(std::ostream& os, const std::vector<std::vector<int>>& videos_per_cache) {
+    int C = videos_per_cache.size();
+    os << C << std::endl;
+    for (int c = 0; c < C; ++c) {
+        os << c;
+        for (int v : videos_per_cache[c]) {
+            os << " " << v;
+        }
+        os << std::endl;
+    }
+}
+
+bool write_solution_atomic(const std::string& path,
+                           const std::vector<std::vector<int>>& videos_per_cache) {
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp);
+        if (!out) return false;
+        write_solution(out, videos_per_cache);
+        if (!out.flush()) return false;
+    }
+    return std::rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+uint64_t hash_solution(const std::vector<std::vector<int>>& videos_per_cache) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    auto mix = [&h](uint32_t x) {
+        for (int b = 0; b < 4; ++b) {
+            h ^= (x >> (8 * b)) & 0xff;
+            h *= 0x100000001b3ULL;
+        }
+    };
+    mix(videos_per_cache.size());
+    for (const std::vector<int>& videos : videos_per_cache) {
+        mix(videos.size());
+        for (int v : videos) mix(v);
+    }
+    return h;
+}
+
+std::ostream& operator<<(std::ostream& os, const Request& r) {
+    return os << "Request(v=" << r.video_id << ", e=" << r.endpoint_id << ", n=" << r.num_req
+              << ")";
+}
+
+std::ostream& operator<<(std::ostream& os, const Endpoint& e) {
+    return os << "Endpoint with " << e.num_connected_caches << " caches and "
+              << e.datacenter_lat << " latency.";
+}
+
+}  // namespace mm
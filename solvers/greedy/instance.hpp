@@ -0,0 +1,108 @@
+#ifndef SRC_INSTANCE_HPP_
+#define SRC_INSTANCE_HPP_
+
+/**
+ * @file
+ * @brief Problem instance shared by all solvers: videos, endpoints and requests, together with
+ * reading of the input format and writing of the output format. All tables of an instance live
+ * in one Arena sized from the header counts.
+ */
+
+#include "includes.hpp"
+#include "arena.hpp"
+
+namespace mm {
+
+/// An endpoint with its datacenter latency and latencies to all connected caches.
+struct Endpoint {
+    int datacenter_lat;
+    avector<int> connected_caches;
+    avector<int> cache_lat;  ///< latency to every cache, -1 if not connected
+    int num_connected_caches;
+
+    /// Construct endpoint with no connections out of `C` caches.
+    Endpoint(int dl, int C, const ArenaAllocator<int>& alloc = ArenaAllocator<int>());
+    /// Connect endpoint to cache `c` with latency `lat`.
+    void connect(int c, int lat);
+};
+
+/// `num_req` requests for video `video_id` coming from endpoint `endpoint_id`.
+struct Request {
+    int video_id, endpoint_id, num_req;
+};
+
+/// A video and the list of requests that want it.
+struct Video {
+    int size;
+    avector<int> request_ids;
+
+    /// Construct video of given size with no requests.
+    explicit Video(int size_ = 0, const ArenaAllocator<int>& alloc = ArenaAllocator<int>())
+            : size(size_), request_ids(alloc) {}
+};
+
+/// Whole problem instance as given in the input file.
+struct Instance {
+    int V, E, R, C, X;
+    std::shared_ptr<Arena> arena;  ///< storage of all tables, null for heap storage
+    avector<Video> videos;
+    avector<Endpoint> endpoints;
+    avector<Request> requests;
+
+    /// Empty instance with heap storage.
+    Instance();
+    /// Empty instance with an arena large enough for the given header counts.
+    Instance(int V_, int E_, int R_, int C_, int X_);
+
+    /// Allocator taking memory from this instance's arena.
+    template <typename T>
+    ArenaAllocator<T> allocator() const { return ArenaAllocator<T>(arena.get()); }
+};
+
+/// Number of bytes an instance with the given header counts needs, at most E*C connections.
+size_t instance_bytes(int V, int E, int R, int C);
+
+/**
+ * Reads instance in the hashcode input format. The stream is left failed if the input is
+ * malformed or truncated; if already its header cannot be read, nothing more is read and an
+ * instance with all counts 0 is returned.
+ */
+Instance read_instance(std::istream& is);
+
+/**
+ * Reads a solution in the hashcode output format for an instance with `C` caches. Like the
+ * official scorer, it rejects a cache listed more than once.
+ * @param error if not null, set to a description of the problem on failure
+ * @return List of videos for every cache, empty on malformed input, cache ids out of range or
+ * repeated caches.
+ */
+std::vector<std::vector<int>> read_solution(std::istream& is, int C,
+                                            std::string* error = nullptr);
+
+/// Writes the list of videos for every cache in the hashcode output format.
+void write_solution(std::ostream& os, const std::vector<std::vector<int>>& videos_per_cache);
+
+/**
+ * Writes solution to `path` through a temporary file renamed over it, so readers of `path` only
+ * ever see a complete solution.
+ * @return False if the file could not be written.
+ */
+bool write_solution_atomic(const std::string& path,
+                           const std::vector<std::vector<int>>& videos_per_cache);
+
+/**
+ * FNV-1a hash of a solution, covering cache count, order of caches and order of videos in every
+ * cache. Different hashes prove the written outputs differ; equal hashes only make identical
+ * outputs very likely, since distinct solutions may collide.
+ */
+uint64_t hash_solution(const std::vector<std::vector<int>>& videos_per_cache);
+
+/// Debug print of a request.
+std::ostream& operator<<(std::ostream& os, const Request& r);
+
+/// Debug print of an endpoint.
+std::ostream& operator<<(std::ostream& os, const Endpoint& e);
+
+}  // namespace mm
+
+#endif  // SRC_INSTANCE_HPP_
@@ -0,0 +1,70 @@
+/**
+ * @file
+ * @brief Implementation of local search declared in local_search.hpp.
+ */
+
+#include "local_search.hpp"
+
+namespace mm {
+
+int64_t improve_cache(Placement& p, int c, MoveScratch& scratch) {
+    const Instance& inst = p.instance();
+    int64_t total = 0;
+    while (true) {
+        p.cache_gains(c, scratch.gains);
+        std::vector<int>& cand = scratch.candidates;
+        cand.clear();
+        for (int v = 0; v < inst.V; ++v) {
+            if (scratch.gains[v] > 0) cand.push_back(v);
+        }
+        const std::vector<int64_t>& gains = scratch.gains;
+        std::sort(cand.begin(), cand.end(), [&gains](int a, int b) {
+            return gains[a] > gains[b] || (gains[a] == gains[b] && a < b);
+        });
+
+        // best video that fits as it is
+        int64_t best = 0;
+        int add = -1, drop = -1;
+        for (int v : cand) {
+            if (inst.videos[v].size <= p.space_left(c)) {
+                best = scratch.gains[v];
+                add = v;
+                break;
+            }
+        }
+        // best replacement for every stored video, gains of other videos do not depend on it
+        for (int u : p.videos(c)) {
+            int64_t loss = p.loss_remove(c, u);
+            int room = p.space_left(c) + inst.videos[u].size;
+            for (int v : cand) {
+                if (scratch.gains[v] - loss <= best) break;
+                if (inst.videos[v].size <= room) {
+                    best = scratch.gains[v] - loss;
+                    add = v;
+                    drop = u;
+                    break;
+                }
+            }
+        }
+        if (add == -1) return total;
+        if (drop != -1) p.remove(c, drop);
+        p.add(c, add);
+        total += best;
+    }
+}
+
+int64_t local_search(Placement& p, const std::function<bool()>& stop) {
+    MoveScratch scratch;
+    int64_t total = 0;
+    int C = p.instance().C, unchanged = 0;
+    if (C == 0) return 0;
+    for (int c = 0; unchanged < C; c = (c + 1) % C) {
+        int64_t gain = improve_cache(p, c, scratch);
+        total += gain;
+        unchanged = gain > 0 ? 0 : unchanged + 1;
+        if (stop()) break;
+    }
+    return total;
+}
+
+}  // namespace mm
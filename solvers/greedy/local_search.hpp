@@ -0,0 +1,36 @@
+#ifndef SRC_LOCAL_SEARCH_HPP_
+#define SRC_LOCAL_SEARCH_HPP_
+
+/**
+ * @file
+ * @brief Improvement of a solution by adding videos to caches and swapping stored videos for
+ * better ones, one cache at a time.
+ */
+
+#include "placement.hpp"
+
+namespace mm {
+
+/// Scratch buffers of improve_cache(), reused between calls.
+struct MoveScratch {
+    std::vector<int64_t> gains;  ///< gain of adding every video
+    std::vector<int> candidates;  ///< videos with positive gain, best first
+};
+
+/**
+ * Repeatedly applies the best improving move on cache `c`: adding a video that fits, or
+ * replacing a stored video with one that fits in its place.
+ * @return Increase of saved latency, 0 if no move improves the solution.
+ */
+int64_t improve_cache(Placement& p, int c, MoveScratch& scratch);
+
+/**
+ * Runs improve_cache() on all caches round robin until a whole round finds no improvement or
+ * `stop()` returns true. `stop` is checked after every cache.
+ * @return Increase of saved latency.
+ */
+int64_t local_search(Placement& p, const std::function<bool()>& stop);
+
+}  // namespace mm
+
+#endif  // SRC_LOCAL_SEARCH_HPP_
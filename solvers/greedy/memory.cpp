@@ -0,0 +1,61 @@
+/**
+ * @file
+ * @brief Implementation of memory accounting declared in memory.hpp.
+ */
+
+#include "memory.hpp"
+#include <sys/resource.h>
+
+namespace mm {
+
+namespace {
+
+std::atomic<bool> report_enabled(false);
+std::mutex report_lock;
+std::atomic<bool> listener_set(false);
+memory_listener_t report_listener;
+
+}  // namespace
+
+size_t peak_rss() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<size_t>(usage.ru_maxrss) * 1024;  // kilobytes on Linux
+}
+
+size_t parse_bytes(const std::string& s) {
+    size_t pos;
+    double amount = std::stod(s, &pos);
+    std::string suffix = s.substr(pos);
+    if (suffix == "k" || suffix == "K") amount *= 1 << 10;
+    else if (suffix == "M") amount *= 1 << 20;
+    else if (suffix == "G") amount *= 1 << 30;
+    else if (!suffix.empty()) throw std::invalid_argument("Unknown size suffix in " + s);
+    return static_cast<size_t>(amount);
+}
+
+void enable_memory_report(bool on) { report_enabled = on; }
+
+void set_memory_listener(const memory_listener_t& listener) {
+    std::lock_guard<std::mutex> guard(report_lock);
+    report_listener = listener;
+    listener_set = static_cast<bool>(listener);
+}
+
+void report_memory(const std::string& phase, const memory_parts_t& parts) {
+    if (!report_enabled && !listener_set) return;
+    std::lock_guard<std::mutex> guard(report_lock);
+    if (report_listener) {
+        size_t total = 0;
+        for (const auto& part : parts) total += part.second;
+        report_listener(phase, total);
+    }
+    if (!report_enabled) return;
+    std::cerr << "Memory after " << phase << ":";
+    for (const auto& part : parts) {
+        std::cerr << " " << part.first << " " << mem2str(part.second) << ",";
+    }
+    std::cerr << " peak RSS " << mem2str(peak_rss()) << std::endl;
+}
+
+}  // namespace mm
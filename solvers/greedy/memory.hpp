@@ -0,0 +1,60 @@
+#ifndef SRC_MEMORY_HPP_
+#define SRC_MEMORY_HPP_
+
+/**
+ * @file
+ * @brief Memory accounting of solver structures. Solvers report bytes held by their main
+ * structures at the end of every phase, which is printed to stderr together with peak RSS when
+ * reports are enabled, so it is clear which structure a large instance runs out of memory on.
+ */
+
+#include "includes.hpp"
+#include "common.hpp"
+
+namespace mm {
+
+/// Bytes held by a table of rows, counting the rows and the table of row headers.
+template <typename table_t>
+size_t nested_mem_used(const table_t& table) {
+    size_t total = mem_used(table);
+    for (const auto& row : table) total += mem_used(row);
+    return total;
+}
+
+/// Bytes allocated by a vector, including unused capacity, e.g. of reserved scratch buffers.
+template <typename vector_t>
+size_t mem_reserved(const vector_t& v) {
+    return sizeof(typename vector_t::value_type) * v.capacity();
+}
+
+/// Peak resident set size of the process in bytes.
+size_t peak_rss();
+
+/// Parses a byte count with optional k, M or G suffix (powers of 1024), e.g. `512M`.
+size_t parse_bytes(const std::string& s);
+
+/// Turns memory reports on or off, they are off by default.
+void enable_memory_report(bool on);
+
+/// Named parts of a memory report with bytes they hold.
+typedef std::vector<std::pair<std::string, size_t>> memory_parts_t;
+
+/// Callback getting the name of every reported phase and the total bytes of its parts.
+typedef std::function<void(const std::string& phase, size_t bytes)> memory_listener_t;
+
+/**
+ * Sets a callback called on every report, also when printing is disabled, e.g. to time phases.
+ * Empty callback removes it.
+ */
+void set_memory_listener(const memory_listener_t& listener);
+
+/**
+ * Prints bytes held by every part after `phase` and current peak RSS to stderr, if reports are
+ * enabled, and passes the total to the listener, if any. Safe to call from concurrently solved
+ * components.
+ */
+void report_memory(const std::string& phase, const memory_parts_t& parts);
+
+}  // namespace mm
+
+#endif  // SRC_MEMORY_HPP_
@@ -0,0 +1,85 @@
+#ifndef SRC_PARALLEL_HPP_
+#define SRC_PARALLEL_HPP_
+
+/**
+ * @file
+ * @brief Scheduling helpers for loops whose iterations have very different costs.
+ */
+
+#include "includes.hpp"
+
+namespace mm {
+
+/// Contiguous range of loop indices owned by one thread.
+struct StealRange {
+    std::mutex lock;  ///< held while the range is shrunk
+    std::atomic<int> begin, end;  ///< remaining indices are [begin, end)
+    char padding[64];  ///< keep ranges of different threads on different cache lines
+
+    StealRange() : begin(0), end(0) {}
+
+    /// Takes the first index of the range, false if empty.
+    bool pop_front(int& i) {
+        std::lock_guard<std::mutex> guard(lock);
+        if (begin >= end) return false;
+        i = begin++;
+        return true;
+    }
+    /// Remaining number of indices, approximate if read without lock.
+    int remaining() const { return end - begin; }
+};
+
+/**
+ * Runs `job(i, thread)` for all `i` in [0, n) on the OpenMP thread team. Every thread starts
+ * with a contiguous share of indices and takes them from the front. When its share is used up it
+ * steals the back half of the largest remaining share, so a few expensive iterations do not
+ * stall the threads that got them. `thread` is smaller than `omp_get_max_threads()` and can be
+ * used to index per-thread scratch space.
+ */
+template <typename job_t>
+void parallel_for_stealing(int n, const job_t& job) {
+    int slots = std::max(1, omp_get_max_threads());
+    std::vector<StealRange> ranges(slots);
+    for (int t = 0; t < slots; ++t) {
+        ranges[t].begin = static_cast<int64_t>(n) * t / slots;
+        ranges[t].end = static_cast<int64_t>(n) * (t + 1) / slots;
+    }
+
+    // shares of threads missing from the team (e.g. in nested regions) get stolen
+    #pragma omp parallel num_threads(slots)
+    {
+        int t = omp_get_thread_num();
+        int i;
+        while (true) {
+            if (ranges[t].pop_front(i)) {
+                job(i, t);
+                continue;
+            }
+            int victim = -1, most = 0;
+            for (int k = 0; k < slots; ++k) {
+                int left = ranges[k].remaining();
+                if (k != t && left > most) {
+                    most = left;
+                    victim = k;
+                }
+            }
+            if (victim == -1) break;
+            int begin, end;
+            {
+                std::lock_guard<std::mutex> guard(ranges[victim].lock);
+                int left = ranges[victim].remaining();
+                if (left <= 0) continue;
+                end = ranges[victim].end;
+                begin = end - (left + 1) / 2;
+                ranges[victim].end = begin;
+            }
+            std::lock_guard<std::mutex> guard(ranges[t].lock);
+            ranges[t].begin = begin;
+            ranges[t].end = end;
+        }
+    }
+}
+
+}  // namespace mm
+
+#endif  // SRC_PARALLEL_HPP_
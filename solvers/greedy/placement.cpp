@@ -0,0 +1,120 @@
+/**
+ * @file
+ * @brief Implementation of incremental solutions declared in placement.hpp.
+ */
+
+#include "placement.hpp"
+
+namespace mm {
+
+PlacementIndex::PlacementIndex(const Instance& inst)
+        : cache_endpoints(inst.C), endpoint_requests(inst.E), total_requests(0) {
+    for (int e = 0; e < inst.E; ++e) {
+        for (int c : inst.endpoints[e].connected_caches) cache_endpoints[c].push_back(e);
+    }
+    for (int i = 0; i < inst.R; ++i) {
+        endpoint_requests[inst.requests[i].endpoint_id].push_back(i);
+        total_requests += inst.requests[i].num_req;
+    }
+}
+
+Placement::Placement(const Instance& inst)
+        : inst_(&inst), index_(std::make_shared<PlacementIndex>(inst)),
+          cached_(static_cast<size_t>(inst.C) * inst.V, 0), videos_(inst.C),
+          space_(inst.C, inst.X), latency_(inst.R), saved_(0) {
+    for (int i = 0; i < inst.R; ++i) {
+        latency_[i] = inst.endpoints[inst.requests[i].endpoint_id].datacenter_lat;
+    }
+}
+
+Placement::Placement(const Instance& inst, const std::vector<std::vector<int>>& videos_per_cache)
+        : Placement(inst) {
+    for (size_t c = 0; c < videos_per_cache.size(); ++c) {
+        for (int v : videos_per_cache[c]) {
+            if (!contains(c, v)) add(c, v);
+        }
+    }
+}
+
+int64_t Placement::score() const {
+    if (index_->total_requests == 0) return 0;
+    return saved_ * 1000 / index_->total_requests;
+}
+
+int64_t Placement::gain_add(int c, int v) const {
+    int64_t gain = 0;
+    for (int rid : inst_->videos[v].request_ids) {
+        const Request& r = inst_->requests[rid];
+        int lat = inst_->endpoints[r.endpoint_id].cache_lat[c];
+        if (lat >= 0 && lat < latency_[rid]) {
+            gain += static_cast<int64_t>(latency_[rid] - lat) * r.num_req;
+        }
+    }
+    return gain;
+}
+
+int Placement::best_latency(int rid, int skip) const {
+    const Request& r = inst_->requests[rid];
+    const Endpoint& ep = inst_->endpoints[r.endpoint_id];
+    int best = ep.datacenter_lat;
+    for (int c : ep.connected_caches) {
+        if (c != skip && contains(c, r.video_id)) best = std::min(best, ep.cache_lat[c]);
+    }
+    return best;
+}
+
+int64_t Placement::loss_remove(int c, int v) const {
+    int64_t loss = 0;
+    for (int rid : inst_->videos[v].request_ids) {
+        const Request& r = inst_->requests[rid];
+        if (inst_->endpoints[r.endpoint_id].cache_lat[c] != latency_[rid]) continue;
+        loss += static_cast<int64_t>(best_latency(rid, c) - latency_[rid]) * r.num_req;
+    }
+    return loss;
+}
+
+void Placement::cache_gains(int c, std::vector<int64_t>& gains) const {
+    gains.assign(inst_->V, 0);
+    for (int e : index_->cache_endpoints[c]) {
+        int lat = inst_->endpoints[e].cache_lat[c];
+        for (int rid : index_->endpoint_requests[e]) {
+            const Request& r = inst_->requests[rid];
+            if (lat < latency_[rid] && !contains(c, r.video_id) &&
+                inst_->videos[r.video_id].size <= inst_->X) {
+                gains[r.video_id] += static_cast<int64_t>(latency_[rid] - lat) * r.num_req;
+            }
+        }
+    }
+}
+
+void Placement::add(int c, int v) {
+    assert(!contains(c, v) && inst_->videos[v].size <= space_[c]);
+    saved_ += gain_add(c, v);
+    for (int rid : inst_->videos[v].request_ids) {
+        int lat = inst_->endpoints[inst_->requests[rid].endpoint_id].cache_lat[c];
+        if (lat >= 0) latency_[rid] = std::min(latency_[rid], lat);
+    }
+    cached_[static_cast<size_t>(c) * inst_->V + v] = 1;
+    videos_[c].push_back(v);
+    space_[c] -= inst_->videos[v].size;
+}
+
+void Placement::remove(int c, int v) {
+    assert(contains(c, v));
+    saved_ -= loss_remove(c, v);
+    for (int rid : inst_->videos[v].request_ids) {
+        const Request& r = inst_->requests[rid];
+        if (inst_->endpoints[r.endpoint_id].cache_lat[c] == latency_[rid]) {
+            latency_[rid] = best_latency(rid, c);
+        }
+    }
+    cached_[static_cast<size_t>(c) * inst_->V + v] = 0;
+    videos_[c].erase(std::find(videos_[c].begin(), videos_[c].end(), v));
+    space_[c] += inst_->videos[v].size;
+}
+
+void Placement::clear(int c) {
+    while (!videos_[c].empty()) remove(c, videos_[c].back());
+}
+
+}  // namespace mm
@@ -0,0 +1,84 @@
+#ifndef SRC_PLACEMENT_HPP_
+#define SRC_PLACEMENT_HPP_
+
+/**
+ * @file
+ * @brief Mutable solution with incrementally maintained saved latency, for improvement heuristics
+ * that try many small changes of a solution.
+ */
+
+#include "instance.hpp"
+
+namespace mm {
+
+/// Endpoints connected to every cache and requests from every endpoint, shared between copies.
+struct PlacementIndex {
+    std::vector<std::vector<int>> cache_endpoints;  ///< endpoints connected to every cache
+    std::vector<std::vector<int>> endpoint_requests;  ///< requests from every endpoint
+    int64_t total_requests;  ///< sum of num_req over all requests
+
+    explicit PlacementIndex(const Instance& inst);
+};
+
+/**
+ * Contents of all caches together with the best latency every request currently gets. Adding
+ * or removing a video updates saved latency in time proportional to the number of requests for
+ * that video. Copies share the instance and its PlacementIndex, which must outlive them.
+ */
+class Placement {
+  public:
+    /// Solution with all caches empty.
+    explicit Placement(const Instance& inst);
+    /// Solution with caches filled with `videos_per_cache`, which must be valid.
+    Placement(const Instance& inst, const std::vector<std::vector<int>>& videos_per_cache);
+
+    /// Instance this is a solution of.
+    const Instance& instance() const { return *inst_; }
+    /// True if cache `c` stores video `v`.
+    bool contains(int c, int v) const { return cached_[static_cast<size_t>(c) * inst_->V + v]; }
+    /// Free space of cache `c` in MB.
+    int space_left(int c) const { return space_[c]; }
+    /// Videos stored in cache `c`, in order of insertion.
+    const std::vector<int>& videos(int c) const { return videos_[c]; }
+    /// Total saved latency, same as saved_latency() from score.hpp.
+    int64_t saved() const { return saved_; }
+    /// Score as reported by the judge, same as score() from score.hpp.
+    int64_t score() const;
+
+    /// Increase of saved latency if video `v` was added to cache `c`.
+    int64_t gain_add(int c, int v) const;
+    /// Decrease of saved latency if video `v` was removed from cache `c`.
+    int64_t loss_remove(int c, int v) const;
+    /**
+     * Computes gain_add() on cache `c` for all videos at once, 0 for videos already stored
+     * there or larger than the cache.
+     * @param gains resized to V
+     */
+    void cache_gains(int c, std::vector<int64_t>& gains) const;
+
+    /// Adds video `v` to cache `c`. It must not be stored there yet and it must fit.
+    void add(int c, int v);
+    /// Removes video `v` from cache `c`, where it must be stored.
+    void remove(int c, int v);
+    /// Removes all videos from cache `c`.
+    void clear(int c);
+
+    /// List of cached videos for every cache.
+    std::vector<std::vector<int>> videos_per_cache() const { return videos_; }
+
+  private:
+    /// Best latency of request `rid` from caches storing its video, other than `skip`.
+    int best_latency(int rid, int skip) const;
+
+    const Instance* inst_;
+    std::shared_ptr<const PlacementIndex> index_;
+    std::vector<char> cached_;  ///< C x V table of stored videos
+    std::vector<std::vector<int>> videos_;
+    std::vector<int> space_;
+    std::vector<int> latency_;  ///< current latency of every request
+    int64_t saved_;
+};
+
+}  // namespace mm
+
+#endif  // SRC_PLACEMENT_HPP_
@@ -0,0 +1,181 @@
+/**
+ * @file
+ * @brief Implementation of exact cache refilling declared in polish.hpp.
+ */
+
+#include "polish.hpp"
+
+namespace mm {
+
+namespace {
+
+/**
+ * Depth first branch and bound for the 0/1 knapsack, items sorted by decreasing value density.
+ * The search keeps its own stack, one frame per item, since there can be thousands of items.
+ */
+class Knapsack {
+  public:
+    Knapsack(const std::vector<int64_t>& value, const std::vector<int>& weight,
+             int64_t node_limit, std::chrono::steady_clock::time_point deadline)
+            : value_(value), weight_(weight), value_sum_(value.size() + 1, 0),
+              weight_sum_(value.size() + 1, 0), take_(value.size(), 0), best_(-1), nodes_(0),
+              node_limit_(node_limit), deadline_(deadline), complete_(true) {
+        for (size_t i = 0; i < value.size(); ++i) {
+            value_sum_[i + 1] = value_sum_[i] + value[i];
+            weight_sum_[i + 1] = weight_sum_[i] + weight[i];
+        }
+    }
+
+    /// Searches for the best subset within `capacity`, returns its value.
+    int64_t solve(int capacity) {
+        // frame i decides item i, starting from the items taken before it
+        std::vector<Frame> stack(value_.size() + 1);
+        stack[0] = {capacity, 0, Frame::enter};
+        size_t i = 0;
+        while (true) {
+            Frame& f = stack[i];
+            if (f.step == Frame::enter) {
+                f.step = expand(i, f.left, f.value) ? Frame::take : Frame::done;
+            }
+            if (f.step == Frame::take) {
+                f.step = Frame::skip;
+                if (weight_[i] <= f.left) {
+                    take_[i] = 1;
+                    stack[i + 1] = {f.left - weight_[i], f.value + value_[i], Frame::enter};
+                    ++i;
+                    continue;
+                }
+            }
+            if (f.step == Frame::skip) {
+                take_[i] = 0;
+                f.step = Frame::done;
+                stack[i + 1] = {f.left, f.value, Frame::enter};
+                ++i;
+                continue;
+            }
+            if (i == 0) break;
+            --i;
+        }
+        return best_;
+    }
+
+    /// Items of the best subset, by index.
+    const std::vector<char>& best_take() const { return best_take_; }
+    /// True if the search was not cut by the node or time limit.
+    bool complete() const { return complete_; }
+
+  private:
+    /// State of the decision on one item.
+    struct Frame {
+        enum Step { enter, take, skip, done };
+        int left;  ///< capacity left
+        int64_t value;  ///< value of the items taken
+        Step step;  ///< what to do when the search gets back to this frame
+    };
+
+    /**
+     * Value of the fractional knapsack on items from `i` on with `capacity` left: whole items
+     * while they fit, found by binary search on prefix sums, and a fraction of the next one.
+     */
+    int64_t bound(size_t i, int capacity) const {
+        size_t n = value_.size();
+        size_t j = std::upper_bound(weight_sum_.begin() + i, weight_sum_.end(),
+                                    weight_sum_[i] + capacity) - weight_sum_.begin() - 1;
+        int64_t b = value_sum_[j] - value_sum_[i];
+        if (j < n) b += (capacity - (weight_sum_[j] - weight_sum_[i])) * value_[j] / weight_[j];
+        return b;
+    }
+
+    /// Records the subset taken so far if it is the best, returns true if item `i` is branched on.
+    bool expand(size_t i, int capacity, int64_t value) {
+        if (value > best_) {
+            best_ = value;
+            best_take_ = take_;
+        }
+        if (i == value_.size() || !complete_) return false;
+        if (++nodes_ > node_limit_ ||
+            ((nodes_ & 1023) == 0 && std::chrono::steady_clock::now() > deadline_)) {
+            complete_ = false;
+            return false;
+        }
+        return value + bound(i, capacity) > best_;
+    }
+
+    const std::vector<int64_t>& value_;
+    const std::vector<int>& weight_;
+    std::vector<int64_t> value_sum_, weight_sum_;
+    std::vector<char> take_, best_take_;
+    int64_t best_, nodes_, node_limit_;
+    std::chrono::steady_clock::time_point deadline_;
+    bool complete_;
+};
+
+}  // namespace
+
+int64_t refill_cache_exact(Placement& p, int c, int64_t node_limit, double time_limit,
+                           bool& optimal) {
+    const Instance& inst = p.instance();
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                            std::chrono::duration<double>(time_limit));
+    int64_t before = p.saved();
+    std::vector<int> old = p.videos(c);
+    p.clear(c);
+    int64_t cleared = p.saved();
+
+    std::vector<int64_t> gains;
+    p.cache_gains(c, gains);
+    std::vector<int> items;
+    for (int v = 0; v < inst.V; ++v) {
+        if (gains[v] > 0) items.push_back(v);
+    }
+    // by decreasing gain per MB, compared exactly as gain(a) * size(b) > gain(b) * size(a),
+    // gains are far below 2^63 / 1000
+    std::sort(items.begin(), items.end(), [&](int a, int b) {
+        int64_t lhs = gains[a] * inst.videos[b].size, rhs = gains[b] * inst.videos[a].size;
+        return lhs > rhs || (lhs == rhs && a < b);
+    });
+    std::vector<int64_t> value(items.size());
+    std::vector<int> weight(items.size());
+    for (size_t i = 0; i < items.size(); ++i) {
+        value[i] = gains[items[i]];
+        weight[i] = inst.videos[items[i]].size;
+    }
+    Knapsack knapsack(value, weight, node_limit, deadline);
+    int64_t best = knapsack.solve(inst.X);
+    optimal = knapsack.complete();
+
+    if (cleared + best > before) {
+        for (size_t i = 0; i < items.size(); ++i) {
+            if (knapsack.best_take()[i]) p.add(c, items[i]);
+        }
+    } else {
+        for (int v : old) p.add(c, v);
+    }
+    return p.saved() - before;
+}
+
+int64_t polish(Placement& p, const PolishParams& params) {
+    int C = p.instance().C;
+    // value of a cache is what removing its videos one at a time would lose
+    std::vector<std::pair<int64_t, int>> value(C);
+    for (int c = 0; c < C; ++c) {
+        value[c] = {0, c};
+        for (int v : p.videos(c)) value[c].first -= p.loss_remove(c, v);
+    }
+    std::sort(value.begin(), value.end());
+
+    int64_t total = 0;
+    int caches = std::min(params.caches, C), optimal = 0;
+    for (int k = 0; k < caches; ++k) {
+        bool proven;
+        total += refill_cache_exact(p, value[k].second, params.node_limit, params.time_limit,
+                                    proven);
+        optimal += proven;
+    }
+    std::cerr << "Polished " << caches << " caches, " << optimal << " proven optimal, saved "
+              << total << " more." << std::endl;
+    return total;
+}
+
+}  // namespace mm
@@ -0,0 +1,48 @@
+#ifndef SRC_POLISH_HPP_
+#define SRC_POLISH_HPP_
+
+/**
+ * @file
+ * @brief Exact refilling of single caches. With all other caches fixed, gains of different
+ * videos on one cache do not depend on each other, so choosing its contents is a 0/1 knapsack
+ * on the gains, solved here by branch and bound.
+ *
+ * Subproblems of several caches at once are not solved exactly: gains on caches sharing
+ * endpoints depend on each other, so they are no knapsack. polish() refills caches one at a
+ * time instead, each with the others fixed.
+ */
+
+#include "placement.hpp"
+
+namespace mm {
+
+/// Parameters of polish().
+struct PolishParams {
+    int caches;  ///< number of most valuable caches to refill
+    int64_t node_limit;  ///< branch and bound nodes per cache
+    double time_limit;  ///< seconds per cache
+
+    PolishParams() : caches(10), node_limit(1000000), time_limit(1.0) {}
+};
+
+/**
+ * Empties cache `c` and refills it with the subset of videos of highest total gain that fits,
+ * found by depth first branch and bound over videos by decreasing gain per MB, with the
+ * fractional knapsack as upper bound. The old contents are kept unless the subset found is
+ * strictly better.
+ * @param optimal set to true if the search finished within the limits
+ * @return Increase of saved latency.
+ */
+int64_t refill_cache_exact(Placement& p, int c, int64_t node_limit, double time_limit,
+                           bool& optimal);
+
+/**
+ * Runs refill_cache_exact() on the `params.caches` caches whose contents save the most, most
+ * valuable first, and reports the result to stderr.
+ * @return Increase of saved latency.
+ */
+int64_t polish(Placement& p, const PolishParams& params);
+
+}  // namespace mm
+
+#endif  // SRC_POLISH_HPP_
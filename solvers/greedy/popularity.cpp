@@ -0,0 +1,68 @@
+/**
+ * @file
+ * @brief Implementation of the popularity fill declared in popularity.hpp.
+ */
+
+#include "popularity.hpp"
+
+namespace mm {
+
+namespace {
+
+/// Maximum over free space of caches, for finding the first cache with enough space.
+class SpaceTree {
+  public:
+    /// `n` caches with `space` free each.
+    SpaceTree(int n, int space) : size_(1) {
+        while (size_ < n) size_ *= 2;
+        tree_.assign(2 * size_, -1);
+        for (int i = 0; i < n; ++i) tree_[size_ + i] = space;
+        for (int i = size_ - 1; i > 0; --i) tree_[i] = std::max(tree_[2*i], tree_[2*i+1]);
+    }
+
+    /// First cache with at least `need` free space, -1 if there is none.
+    int first_fit(int need) const {
+        if (tree_[1] < need) return -1;
+        int i = 1;
+        while (i < size_) i = tree_[2*i] >= need ? 2*i : 2*i + 1;
+        return i - size_;
+    }
+
+    /// Decreases free space of cache `c` by `amount`.
+    void take(int c, int amount) {
+        int i = size_ + c;
+        tree_[i] -= amount;
+        for (i /= 2; i > 0; i /= 2) tree_[i] = std::max(tree_[2*i], tree_[2*i+1]);
+    }
+
+  private:
+    int size_;  ///< number of leaves, a power of two
+    std::vector<int> tree_;  ///< node i has children 2i and 2i+1, leaves start at size_
+};
+
+}  // namespace
+
+std::vector<std::vector<int>> popularity_fill(const Instance& inst) {
+    std::vector<std::tuple<int64_t, int, int>> order;
+    order.reserve(inst.V);
+    for (int v = 0; v < inst.V; ++v) {
+        int64_t total = 0;
+        for (int rid : inst.videos[v].request_ids) total += inst.requests[rid].num_req;
+        order.push_back(std::make_tuple(total, inst.videos[v].size, v));
+    }
+    std::sort(order.rbegin(), order.rend());
+
+    std::vector<std::vector<int>> videos_per_cache(inst.C);
+    if (inst.C == 0) return videos_per_cache;
+    SpaceTree space(inst.C, inst.X);
+    for (const auto& item : order) {
+        int v = std::get<2>(item), size = std::get<1>(item);
+        int c = space.first_fit(size);
+        if (c == -1) continue;
+        space.take(c, size);
+        videos_per_cache[c].push_back(v);
+    }
+    return videos_per_cache;
+}
+
+}  // namespace mm
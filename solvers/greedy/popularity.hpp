@@ -0,0 +1,23 @@
+#ifndef SRC_POPULARITY_HPP_
+#define SRC_POPULARITY_HPP_
+
+/**
+ * @file
+ * @brief Popularity fill of fill.py, a fast baseline and warm start ignoring latencies.
+ */
+
+#include "instance.hpp"
+
+namespace mm {
+
+/**
+ * Takes videos by total number of requests, then size, then id, all descending, and puts every
+ * video into the first cache with enough space left, same as fill.py. The first fitting cache is
+ * found in a max segment tree over free space, so this runs in O(V log V + V log C).
+ * @return List of cached videos for every cache.
+ */
+std::vector<std::vector<int>> popularity_fill(const Instance& inst);
+
+}  // namespace mm
+
+#endif  // SRC_POPULARITY_HPP_
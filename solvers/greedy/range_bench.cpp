@@ -0,0 +1,153 @@
+/**
+ * @file
+ * @brief Microbenchmarks of Range and VecX multi-indexed access and filter against raw
+ * std::vector loops. Every variant is checked against the raw loop first and the benchmark
+ * exits with 1 if any result differs, so it doubles as a check of the containers.
+ * Usage:
+ *     range_bench [--size N] [--repeat K] [--seed S]
+ * Prints the best time over K repetitions in nanoseconds per element.
+ */
+
+#include "types.hpp"
+#include "driver.hpp"
+
+using namespace mm;
+using namespace std;
+
+int failures = 0;
+
+/// Best time of `repeat` runs of `f` in nanoseconds per element.
+template <typename func_t>
+double best_ns(int repeat, int elements, const func_t& f) {
+    double best = numeric_limits<double>::max();
+    for (int k = 0; k < repeat; ++k) {
+        auto start = chrono::steady_clock::now();
+        f();
+        best = min(best, chrono::duration<double>(chrono::steady_clock::now() - start).count());
+    }
+    return best * 1e9 / max(1, elements);
+}
+
+/// Times `f` over `elements` elements, then prints the time and whether `check()` holds.
+template <typename func_t, typename check_t>
+void run(const string& name, const string& variant, int repeat, int elements, const func_t& f,
+         const check_t& check) {
+    double ns = best_ns(repeat, elements, f);
+    bool ok = check();
+    cout << setw(10) << name << setw(22) << variant << setw(10) << fixed << setprecision(3) << ns
+         << (ok ? "" : "  MISMATCH") << endl;
+    if (!ok) ++failures;
+}
+
+int main(int argc, char* argv[]) {
+    Options opt(argc, argv);
+    int n = opt.get_int("size", 1 << 20), repeat = opt.get_int("repeat", 10);
+    mt19937 rng(opt.seed());
+    uniform_real_distribution<double> value(0, 1);
+    uniform_int_distribution<int> position(0, n - 1);
+
+    vector<double> raw(n);
+    for (double& x : raw) x = value(rng);
+    Range<double> range(raw);
+    const Range<double>& crange = range;
+    VecXd vec(n);
+    for (int i = 0; i < n; ++i) vec[i] = raw[i];
+    const VecXd& cvec = vec;
+    indexes_t idx(n / 4);
+    for (int& i : idx) i = position(rng);
+    int m = idx.size();
+    volatile double sink = 0;
+
+    cout << setw(10) << "case" << setw(22) << "variant" << setw(10) << "ns/elem" << endl;
+
+    // single element reads, Range asserts every index
+    double expected_sum = accumulate(raw.begin(), raw.end(), 0.0);
+    double sum = 0;
+    run("read", "vector loop", repeat, n, [&]() {
+        double s = 0;
+        for (int i = 0; i < n; ++i) s += raw[i];
+        sink = s;
+    }, [&]() { return true; });
+    run("read", "Range loop", repeat, n, [&]() {
+        double s = 0;
+        for (int i = 0; i < n; ++i) s += crange[i];
+        sum = s;
+    }, [&]() { return sum == expected_sum; });
+
+    // gathers of a random index list
+    vector<double> gathered(m);
+    for (int i = 0; i < m; ++i) gathered[i] = raw[idx[i]];
+    double gathered_sum = accumulate(gathered.begin(), gathered.end(), 0.0);
+    vector<double> buffer(m);
+    run("gather", "vector loop", repeat, m, [&]() {
+        for (int i = 0; i < m; ++i) buffer[i] = raw[idx[i]];
+        sink = buffer[m / 2];
+    }, [&]() { return buffer == gathered; });
+    Range<double> materialised;
+    run("gather", "Range[indexes]", repeat, m, [&]() {
+        materialised = crange[idx];
+    }, [&]() { return materialised == Range<double>(gathered); });
+    VecXd vec_materialised;
+    run("gather", "VecX[indexes]", repeat, m, [&]() {
+        vec_materialised = cvec[idx];
+    }, [&]() {
+        return vector<double>(vec_materialised.begin(), vec_materialised.end()) == gathered;
+    });
+    run("gather+sum", "vector loop", repeat, m, [&]() {
+        double s = 0;
+        for (int i = 0; i < m; ++i) s += raw[idx[i]];
+        sum = s;
+    }, [&]() { return sum == gathered_sum; });
+    run("gather+sum", "Range[indexes]", repeat, m, [&]() {
+        Range<double> g = crange[idx];
+        sum = accumulate(g.begin(), g.end(), 0.0);
+    }, [&]() { return sum == gathered_sum; });
+    run("gather+sum", "IndexView", repeat, m, [&]() {
+        double s = 0;
+        for (double x : crange.view(idx)) s += x;
+        sum = s;
+    }, [&]() { return sum == gathered_sum; });
+
+    // scatter of a constant through an index list
+    vector<double> scattered = raw;
+    for (int i : idx) scattered[i] = 0.5;
+    vector<double> raw_copy = raw;
+    run("scatter", "vector loop", repeat, m, [&]() {
+        for (int i = 0; i < m; ++i) raw_copy[idx[i]] = 0.5;
+    }, [&]() { return raw_copy == scattered; });
+    Range<double> range_copy(raw);
+    run("scatter", "RangeView = x", repeat, m, [&]() {
+        range_copy[idx] = 0.5;
+    }, [&]() { return range_copy == Range<double>(scattered); });
+
+    // index lists of elements satisfying a predicate
+    auto pred = [](double x) { return x < 0.3; };
+    indexes_t expected;
+    for (int i = 0; i < n; ++i) {
+        if (pred(raw[i])) expected.push_back(i);
+    }
+    indexes_t result;
+    run("filter", "vector loop", repeat, n, [&]() {
+        indexes_t r;
+        for (int i = 0; i < n; ++i) {
+            if (pred(raw[i])) r.push_back(i);
+        }
+        result.swap(r);
+    }, [&]() { return result == expected; });
+    run("filter", "Range::filter", repeat, n, [&]() {
+        result = crange.filter(pred);
+    }, [&]() { return result == expected; });
+    run("filter", "Range < x", repeat, n, [&]() {
+        result = crange < 0.3;
+    }, [&]() { return result == expected; });
+    indexes_t reused;
+    run("filter", "Range::filter_into", repeat, n, [&]() {
+        crange.filter_into(pred, reused);
+    }, [&]() { return reused == expected; });
+    run("filter", "VecX::filter", repeat, n, [&]() {
+        result = cvec.filter(pred);
+    }, [&]() { return result == expected; });
+
+    if (failures) cerr << failures << " variants differ from the vector loops." << endl;
+    return failures ? 1 : 0;
+}
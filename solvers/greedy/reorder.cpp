@@ -0,0 +1,77 @@
+/**
+ * @file
+ * @brief Implementation of instance renumbering declared in reorder.hpp.
+ */
+
+#include "reorder.hpp"
+
+namespace mm {
+
+Reordered reorder(const Instance& inst) {
+    Reordered res;
+    int V = inst.V, E = inst.E, R = inst.R;
+
+    std::vector<int64_t> popularity(V, 0);
+    for (const Request& r : inst.requests) popularity[r.video_id] += r.num_req;
+    res.video_ids.resize(V);
+    for (int v = 0; v < V; ++v) res.video_ids[v] = v;
+    std::stable_sort(res.video_ids.begin(), res.video_ids.end(), [&](int a, int b) {
+        return popularity[a] > popularity[b];
+    });
+
+    std::vector<std::vector<int>> cache_sets(E);
+    for (int e = 0; e < E; ++e) {
+        const Endpoint& ep = inst.endpoints[e];
+        cache_sets[e].assign(ep.connected_caches.begin(), ep.connected_caches.end());
+        std::sort(cache_sets[e].begin(), cache_sets[e].end());
+    }
+    res.endpoint_ids.resize(E);
+    for (int e = 0; e < E; ++e) res.endpoint_ids[e] = e;
+    std::stable_sort(res.endpoint_ids.begin(), res.endpoint_ids.end(), [&](int a, int b) {
+        if (cache_sets[a] != cache_sets[b]) return cache_sets[a] < cache_sets[b];
+        return inst.endpoints[a].datacenter_lat < inst.endpoints[b].datacenter_lat;
+    });
+
+    std::vector<int> video_new(V), endpoint_new(E);
+    for (int v = 0; v < V; ++v) video_new[res.video_ids[v]] = v;
+    for (int e = 0; e < E; ++e) endpoint_new[res.endpoint_ids[e]] = e;
+
+    res.instance = Instance(V, E, R, inst.C, inst.X);
+    Instance& out = res.instance;
+    for (int v : res.video_ids) {
+        out.videos.emplace_back(inst.videos[v].size, out.allocator<int>());
+    }
+    for (int e : res.endpoint_ids) {
+        const Endpoint& ep = inst.endpoints[e];
+        out.endpoints.emplace_back(ep.datacenter_lat, out.C, out.allocator<int>());
+        out.endpoints.back().connected_caches.reserve(ep.num_connected_caches);
+        for (int c : cache_sets[e]) out.endpoints.back().connect(c, ep.cache_lat[c]);
+    }
+
+    out.requests.resize(R);
+    for (int i = 0; i < R; ++i) {
+        const Request& r = inst.requests[i];
+        out.requests[i] = {video_new[r.video_id], endpoint_new[r.endpoint_id], r.num_req};
+    }
+    std::stable_sort(out.requests.begin(), out.requests.end(),
+                     [](const Request& a, const Request& b) {
+        if (a.video_id != b.video_id) return a.video_id < b.video_id;
+        return a.endpoint_id < b.endpoint_id;
+    });
+    std::vector<int> count(V, 0);
+    for (const Request& r : out.requests) count[r.video_id]++;
+    for (int v = 0; v < V; ++v) out.videos[v].request_ids.reserve(count[v]);
+    for (int i = 0; i < R; ++i) out.videos[out.requests[i].video_id].request_ids.push_back(i);
+    return res;
+}
+
+std::vector<std::vector<int>> solve_reordered(const Instance& inst, const solver_t& solver) {
+    Reordered reordered = reorder(inst);
+    std::vector<std::vector<int>> videos_per_cache = solver(reordered.instance);
+    for (std::vector<int>& videos : videos_per_cache) {
+        for (int& v : videos) v = reordered.video_ids[v];
+    }
+    return videos_per_cache;
+}
+
+}  // namespace mm
@@ -0,0 +1,35 @@
+#ifndef SRC_REORDER_HPP_
+#define SRC_REORDER_HPP_
+
+/**
+ * @file
+ * @brief Renumbering of an instance for memory locality. Popular videos get small ids, so their
+ * savings share cache lines, endpoints with similar cache sets get adjacent ids and requests are
+ * sorted by video and endpoint, so loops over the requests of a video walk memory sequentially.
+ */
+
+#include "instance.hpp"
+#include "greedy.hpp"
+
+namespace mm {
+
+/// Instance with renumbered videos, endpoints and requests, with maps back to original ids.
+struct Reordered {
+    Instance instance;  ///< same problem, caches keep their ids
+    std::vector<int> video_ids;  ///< original id of every video
+    std::vector<int> endpoint_ids;  ///< original id of every endpoint
+};
+
+/**
+ * Renumbers videos by decreasing total number of requests, endpoints by their sorted list of
+ * connected caches and then datacenter latency, and sorts requests by (video, endpoint). Ties
+ * keep the original order, so the result depends only on the instance.
+ */
+Reordered reorder(const Instance& inst);
+
+/// Solves the reordered instance with `solver` and maps the result back to original video ids.
+std::vector<std::vector<int>> solve_reordered(const Instance& inst, const solver_t& solver);
+
+}  // namespace mm
+
+#endif  // SRC_REORDER_HPP_
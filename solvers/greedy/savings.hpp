@@ -0,0 +1,96 @@
+#ifndef SRC_SAVINGS_HPP_
+#define SRC_SAVINGS_HPP_
+
+/**
+ * @file
+ * @brief Dense C x V table of savings in one contiguous block, in a layout matching how a
+ * solver phase walks it.
+ */
+
+#include "arena.hpp"
+
+namespace mm {
+
+/// Order of savings in a SavingsMatrix.
+enum class SavingsLayout {
+    video_major,  ///< savings of one video on all caches are contiguous, for column scans
+    cache_major,  ///< savings of all videos on one cache are contiguous, for row scans
+    tiled  ///< tiles of 8 caches x 64 videos, for phases that scan both ways
+};
+
+/**
+ * Savings of every (cache, video) pair in a single allocation. Element access works in every
+ * layout, contiguous rows and columns are available in cache and video major layouts.
+ */
+template <typename save_t>
+class SavingsMatrix {
+  public:
+    static const int TILE_C = 8;  ///< caches per tile
+    static const int TILE_V = 64;  ///< videos per tile
+
+    /// Zero savings of `C` caches and `V` videos stored in `layout`, allocated by `alloc`.
+    SavingsMatrix(int C, int V, SavingsLayout layout, const ArenaAllocator<save_t>& alloc)
+            : C_(C), V_(V), tiles_v_((V + TILE_V - 1) / TILE_V), layout_(layout),
+              data_(alloc) {
+        size_t n = static_cast<size_t>(C) * V;
+        if (layout == SavingsLayout::tiled) {
+            n = static_cast<size_t>((C + TILE_C - 1) / TILE_C) * TILE_C * tiles_v_ * TILE_V;
+        }
+        data_.assign(n, 0);
+    }
+
+    /// Layout the savings are stored in.
+    SavingsLayout layout() const { return layout_; }
+
+    /// Saving of video `v` on cache `c`.
+    save_t& operator()(int c, int v) { return data_[index(c, v)]; }
+    /// Saving of video `v` on cache `c`.
+    save_t operator()(int c, int v) const { return data_[index(c, v)]; }
+
+    /// Savings of all videos on cache `c`, only in cache major layout.
+    save_t* row(int c) {
+        assert(layout_ == SavingsLayout::cache_major);
+        return &data_[static_cast<size_t>(c) * V_];
+    }
+    /// Savings of video `v` on all caches, only in video major layout.
+    save_t* column(int v) {
+        assert(layout_ == SavingsLayout::video_major);
+        return &data_[static_cast<size_t>(v) * C_];
+    }
+
+    /// Copies savings of cache `c` into `out` of size V, in any layout.
+    void copy_row(int c, save_t* out) const {
+        if (layout_ == SavingsLayout::cache_major) {
+            std::copy_n(&data_[static_cast<size_t>(c) * V_], V_, out);
+        } else if (layout_ == SavingsLayout::tiled) {
+            for (int t = 0; t < tiles_v_; ++t) {
+                const save_t* tile = &data_[index(c, t * TILE_V)];
+                std::copy_n(tile, std::min(TILE_V, V_ - t * TILE_V), out + t * TILE_V);
+            }
+        } else {
+            for (int v = 0; v < V_; ++v) out[v] = data_[static_cast<size_t>(v) * C_ + c];
+        }
+    }
+
+    /// Bytes held by the matrix.
+    size_t bytes() const { return sizeof(save_t) * data_.size(); }
+
+  private:
+    size_t index(int c, int v) const {
+        switch (layout_) {
+            case SavingsLayout::video_major: return static_cast<size_t>(v) * C_ + c;
+            case SavingsLayout::cache_major: return static_cast<size_t>(c) * V_ + v;
+            default:
+                return ((static_cast<size_t>(c / TILE_C) * tiles_v_ + v / TILE_V) * TILE_C +
+                        c % TILE_C) * TILE_V + v % TILE_V;
+        }
+    }
+
+    int C_, V_, tiles_v_;
+    SavingsLayout layout_;
+    avector<save_t> data_;
+};
+
+}  // namespace mm
+
+#endif  // SRC_SAVINGS_HPP_
@@ -0,0 +1,121 @@
+/**
+ * @file
+ * @brief Scaling benchmark of a solver on random instances.
+ * Usage:
+ *     scaling [--V list] [--R list] [--C list] [--thread-list list] [--E N] [--X N] [--zipf S]
+ *             [--solver name] [--max-memory B] [--parse] [--seed N]
+ * Lists are comma separated, every combination of them is one instance solved with every
+ * thread count. Prints CSV with one row per phase: generating the instance, parsing its text
+ * with `--parse`, every phase the solver reports through report_memory() and the whole solve.
+ * Rows give the duration of the phase, requests and placed videos per second and bytes held at
+ * its end. Peak RSS is of the whole process, so it only grows between rows.
+ */
+
+#include <iostream>
+#include <vector>
+#include "includes.hpp"
+#include "common.hpp"
+#include "instance.hpp"
+#include "greedy.hpp"
+#include "generator.hpp"
+#include "driver.hpp"
+#include "memory.hpp"
+
+using namespace mm;
+using namespace std;
+
+typedef chrono::steady_clock::time_point time_point_t;
+
+double seconds_between(time_point_t start, time_point_t end) {
+    return chrono::duration<double>(end - start).count();
+}
+
+/// Parses a comma separated list of integers.
+vector<int> parse_list(const string& s) {
+    vector<int> values;
+    stringstream ss(s);
+    string item;
+    while (getline(ss, item, ',')) values.push_back(stoi(item));
+    return values;
+}
+
+/// Prints one CSV row, rates are left empty if their count is 0.
+void print_row(const GeneratorParams& params, int threads, const string& phase, double seconds,
+               int64_t requests, int64_t placements, size_t bytes) {
+    auto rate = [seconds](int64_t count) {
+        return count > 0 && seconds > 0 ? to_string(static_cast<int64_t>(count / seconds)) : "";
+    };
+    cout << params.V << "," << params.E << "," << params.R << "," << params.C << "," << params.X
+         << "," << threads << "," << phase << "," << fixed << setprecision(6) << seconds << ","
+         << rate(requests) << "," << rate(placements) << "," << bytes << "," << peak_rss()
+         << endl;
+}
+
+int main(int argc, char* argv[]) {
+    Options opt(argc, argv);
+    vector<int> Vs = parse_list(opt.get("V", "1000,10000"));
+    vector<int> Rs = parse_list(opt.get("R", "100000,1000000"));
+    vector<int> Cs = parse_list(opt.get("C", "10,100"));
+    vector<int> thread_counts = parse_list(opt.get("thread-list", "1,2,4"));
+    string solver_name = opt.get("solver", "greedy2");
+    solver_t solver = solver_by_name(solver_name, parse_bytes(opt.get("max-memory", "0")));
+    if (!solver) {
+        cerr << "Unknown solver " << solver_name << "." << endl;
+        return 1;
+    }
+
+    cout << "V,E,R,C,X,threads,phase,seconds,requests_per_s,placements_per_s,bytes,peak_rss"
+         << endl;
+    for (int V : Vs) for (int R : Rs) for (int C : Cs) {
+        GeneratorParams params;
+        params.V = V;
+        params.E = opt.get_int("E", 1000);
+        params.R = R;
+        params.C = C;
+        params.X = opt.get_int("X", 50000);
+        params.zipf = opt.get_double("zipf", params.zipf);
+        params.seed = opt.seed();
+        cerr << "V=" << V << " R=" << R << " C=" << C << endl;
+
+        time_point_t start = chrono::steady_clock::now();
+        Instance inst = random_instance(params);
+        print_row(params, 0, "generate", seconds_between(start, chrono::steady_clock::now()), R,
+                  0, inst.arena->used());
+        if (opt.has("parse")) {
+            stringstream text;
+            write_random_instance(text, params);
+            start = chrono::steady_clock::now();
+            Instance parsed = read_instance(text);
+            print_row(params, 0, "parse", seconds_between(start, chrono::steady_clock::now()), R,
+                      0, parsed.arena->used());
+        }
+
+        for (int threads : thread_counts) {
+            omp_set_num_threads(threads);
+            vector<tuple<string, time_point_t, size_t>> phases;
+            set_memory_listener([&phases](const string& phase, size_t bytes) {
+                phases.emplace_back(phase, chrono::steady_clock::now(), bytes);
+            });
+            start = chrono::steady_clock::now();
+            vector<vector<int>> videos_per_cache = solver(inst);
+            time_point_t end = chrono::steady_clock::now();
+            set_memory_listener(nullptr);
+
+            int64_t placements = 0;
+            for (const vector<int>& videos : videos_per_cache) placements += videos.size();
+            time_point_t previous = start;
+            size_t max_bytes = 0;
+            for (size_t i = 0; i < phases.size(); ++i) {
+                time_point_t time = get<1>(phases[i]);
+                // placements are made in the last phase
+                print_row(params, threads, get<0>(phases[i]), seconds_between(previous, time), R,
+                          i + 1 == phases.size() ? placements : 0, get<2>(phases[i]));
+                previous = time;
+                max_bytes = max(max_bytes, get<2>(phases[i]));
+            }
+            print_row(params, threads, solver_name, seconds_between(start, end), R, placements,
+                      max_bytes);
+        }
+    }
+    return 0;
+}
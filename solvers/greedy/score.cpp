@@ -0,0 +1,133 @@
+/**
+ * @file
+ * @brief Implementation of solution checking and scoring declared in score.hpp.
+ */
+
+#include "score.hpp"
+
+namespace mm {
+
+std::string check_solution(const Instance& inst,
+                           const std::vector<std::vector<int>>& videos_per_cache) {
+    if (static_cast<int>(videos_per_cache.size()) > inst.C) {
+        return "using more caches than are available";
+    }
+    for (size_t c = 0; c < videos_per_cache.size(); ++c) {
+        int64_t used = 0;
+        for (int v : videos_per_cache[c]) {
+            if (v < 0 || v >= inst.V) {
+                std::stringstream ss;
+                ss << "cache #" << c << " stores nonexistent video " << v;
+                return ss.str();
+            }
+            used += inst.videos[v].size;
+        }
+        if (used > inst.X) {
+            std::stringstream ss;
+            ss << "storing " << used << "MB (X=" << inst.X << "MB) in cache #" << c;
+            return ss.str();
+        }
+    }
+    return "";
+}
+
+std::vector<int> request_latencies(const Instance& inst,
+                                   const std::vector<std::vector<int>>& videos_per_cache) {
+    std::vector<std::vector<int>> caches_of_video(inst.V);
+    for (size_t c = 0; c < videos_per_cache.size(); ++c) {
+        for (int v : videos_per_cache[c]) caches_of_video[v].push_back(c);
+    }
+    std::vector<int> latency(inst.R);
+    for (int i = 0; i < inst.R; ++i) {
+        const Request& r = inst.requests[i];
+        const Endpoint& e = inst.endpoints[r.endpoint_id];
+        int best = e.datacenter_lat;
+        for (int c : caches_of_video[r.video_id]) {
+            if (e.cache_lat[c] >= 0) best = std::min(best, e.cache_lat[c]);
+        }
+        latency[i] = best;
+    }
+    return latency;
+}
+
+namespace {
+
+typedef std::vector<std::vector<int>> solution_t;
+
+/**
+ * Saved latency of every solution. Bits of caches storing a video are kept per video with the
+ * rows of all solutions next to each other, so a request reads a few adjacent words.
+ */
+std::vector<int64_t> saved_latencies(const Instance& inst,
+                                     const std::vector<const solution_t*>& solutions) {
+    int S = solutions.size();
+    size_t words = (inst.C + 63) / 64;  // words of one row
+    std::vector<uint64_t> stored(static_cast<size_t>(inst.V) * S * words, 0);
+    for (int s = 0; s < S; ++s) {
+        const solution_t& videos_per_cache = *solutions[s];
+        for (size_t c = 0; c < videos_per_cache.size(); ++c) {
+            for (int v : videos_per_cache[c]) {
+                stored[(static_cast<size_t>(v) * S + s) * words + c / 64] |= 1ULL << (c % 64);
+            }
+        }
+    }
+
+    std::vector<int64_t> saved(S, 0);
+    #pragma omp parallel
+    {
+        std::vector<int64_t> local(S, 0);
+        #pragma omp for schedule(static)
+        for (int i = 0; i < inst.R; ++i) {
+            const Request& r = inst.requests[i];
+            const Endpoint& e = inst.endpoints[r.endpoint_id];
+            const uint64_t* row = &stored[static_cast<size_t>(r.video_id) * S * words];
+            for (int s = 0; s < S; ++s, row += words) {
+                int best = e.datacenter_lat;
+                for (int c : e.connected_caches) {
+                    if ((row[c / 64] >> (c % 64)) & 1) best = std::min(best, e.cache_lat[c]);
+                }
+                local[s] += static_cast<int64_t>(e.datacenter_lat - best) * r.num_req;
+            }
+        }
+        #pragma omp critical
+        for (int s = 0; s < S; ++s) saved[s] += local[s];
+    }
+    return saved;
+}
+
+/// Total number of requests, 0 means the score is 0.
+int64_t total_requests(const Instance& inst) {
+    int64_t total = 0;
+    for (const Request& r : inst.requests) total += r.num_req;
+    return total;
+}
+
+}  // namespace
+
+int64_t saved_latency(const Instance& inst,
+                      const std::vector<std::vector<int>>& videos_per_cache) {
+    return saved_latencies(inst, std::vector<const solution_t*>{&videos_per_cache})[0];
+}
+
+std::vector<int64_t> saved_latencies(const Instance& inst,
+                                     const std::vector<std::vector<std::vector<int>>>& solutions) {
+    std::vector<const solution_t*> pointers;
+    for (const solution_t& solution : solutions) pointers.push_back(&solution);
+    return saved_latencies(inst, pointers);
+}
+
+int64_t score(const Instance& inst, const std::vector<std::vector<int>>& videos_per_cache) {
+    int64_t total = total_requests(inst);
+    if (total == 0) return 0;
+    return saved_latency(inst, videos_per_cache) * 1000 / total;
+}
+
+std::vector<int64_t> scores(const Instance& inst,
+                            const std::vector<std::vector<std::vector<int>>>& solutions) {
+    std::vector<int64_t> saved = saved_latencies(inst, solutions);
+    int64_t total = total_requests(inst);
+    for (int64_t& s : saved) s = total == 0 ? 0 : s * 1000 / total;
+    return saved;
+}
+
+}  // namespace mm
@@ -0,0 +1,51 @@
+#ifndef SRC_SCORE_HPP_
+#define SRC_SCORE_HPP_
+
+/**
+ * @file
+ * @brief Solution checking and scoring, same as scoring.py.
+ */
+
+#include "instance.hpp"
+
+namespace mm {
+
+/**
+ * Checks that the solution uses existing caches and videos and respects capacity X.
+ * @return Empty string if solution is valid, description of the first problem otherwise.
+ */
+std::string check_solution(const Instance& inst,
+                           const std::vector<std::vector<int>>& videos_per_cache);
+
+/**
+ * Best latency every request gets from the datacenter and the caches storing its video, in order
+ * of requests.
+ */
+std::vector<int> request_latencies(const Instance& inst,
+                                   const std::vector<std::vector<int>>& videos_per_cache);
+
+/**
+ * Total saved latency, i.e., sum over requests of `num_req * (datacenter latency - best
+ * latency)`. Videos stored multiple times in a cache count once.
+ */
+int64_t saved_latency(const Instance& inst,
+                      const std::vector<std::vector<int>>& videos_per_cache);
+
+/**
+ * Saved latency of every solution in `solutions`, as saved_latency(), in one pass over the
+ * requests. Requests are split between OpenMP threads, which sum into their own accumulators
+ * and look videos up in a C x V bitset of every solution, shared read-only.
+ */
+std::vector<int64_t> saved_latencies(const Instance& inst,
+                                     const std::vector<std::vector<std::vector<int>>>& solutions);
+
+/// Score as reported by the judge: average saved latency per request in microseconds.
+int64_t score(const Instance& inst, const std::vector<std::vector<int>>& videos_per_cache);
+
+/// Scores of all solutions, computed with saved_latencies().
+std::vector<int64_t> scores(const Instance& inst,
+                            const std::vector<std::vector<std::vector<int>>>& solutions);
+
+}  // namespace mm
+
+#endif  // SRC_SCORE_HPP_
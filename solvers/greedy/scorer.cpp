@@ -0,0 +1,64 @@
+/**
+ * @file
+ * @brief Checks and scores solutions like scoring.py, many at once.
+ * Usage:
+ *     scorer input.in solution1.out [solution2.out ...]
+ * Prints the score of every solution in the order given. All valid solutions are scored in one
+ * parallel pass over the requests, see saved_latencies(). Exits with 1 if any solution is
+ * invalid.
+ */
+
+#include <iostream>
+#include <vector>
+#include "includes.hpp"
+#include "common.hpp"
+#include "instance.hpp"
+#include "score.hpp"
+#include "driver.hpp"
+
+using namespace mm;
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    Options opt(argc, argv);
+    if (opt.positional.size() < 2) {
+        cerr << "Usage: scorer input.in solution1.out [solution2.out ...]" << endl;
+        return 1;
+    }
+    ifstream in(opt.positional[0]);
+    if (!in.is_open()) {
+        cerr << "Cannot open instance " << opt.positional[0] << "." << endl;
+        return 1;
+    }
+    Instance inst = read_instance(in);
+    if (in.fail()) {
+        cerr << "Cannot read instance " << opt.positional[0] << "." << endl;
+        return 1;
+    }
+
+    vector<string> paths(opt.positional.begin() + 1, opt.positional.end());
+    vector<vector<vector<int>>> solutions;
+    vector<string> errors(paths.size());
+    for (size_t i = 0; i < paths.size(); ++i) {
+        ifstream sol(paths[i]);
+        if (!sol.is_open()) {
+            errors[i] = "cannot open solution";
+            continue;
+        }
+        vector<vector<int>> videos_per_cache = read_solution(sol, inst.C, &errors[i]);
+        if (errors[i].empty()) errors[i] = check_solution(inst, videos_per_cache);
+        if (errors[i].empty()) solutions.push_back(move(videos_per_cache));
+    }
+
+    vector<int64_t> result = scores(inst, solutions);
+    bool ok = true;
+    for (size_t i = 0, k = 0; i < paths.size(); ++i) {
+        if (errors[i].empty()) {
+            cout << paths[i] << " " << result[k++] << endl;
+        } else {
+            cout << paths[i] << " invalid: " << errors[i] << endl;
+            ok = false;
+        }
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,250 @@
+/**
+ * @file
+ * @brief Implementation of vectorised kernels declared in simd.hpp.
+ */
+
+#include "simd.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define MM_HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+namespace mm {
+namespace simd {
+
+namespace {
+
+/// Portable implementations, also used for tails of vectorised loops.
+namespace scalar {
+
+template <typename save_t>
+void accumulate_savings(save_t* out, const int32_t* lat, int32_t dc, int32_t num_req, int n) {
+    for (int i = 0; i < n; ++i) {
+        out[i] += (lat[i] >= 0) ? static_cast<save_t>(num_req * (dc - lat[i])) : 0;
+    }
+}
+
+template <typename save_t>
+void accumulate_positive(save_t* out, const int32_t* lat, int32_t cur, int32_t num_req, int n) {
+    for (int i = 0; i < n; ++i) {
+        out[i] += (out[i] > 0) ? static_cast<save_t>(num_req * std::max(0, cur - lat[i])) : 0;
+    }
+}
+
+template <typename save_t>
+int argmax_first(const save_t* a, int n) {
+    int best = n > 0 ? 0 : -1;
+    for (int i = 1; i < n; ++i) {
+        if (a[i] > a[best]) best = i;
+    }
+    return best;
+}
+
+template <typename save_t>
+int argmax_last(const save_t* a, int n) {
+    int best = n > 0 ? 0 : -1;
+    for (int i = 1; i < n; ++i) {
+        if (a[i] >= a[best]) best = i;
+    }
+    return best;
+}
+
+}  // namespace scalar
+
+#ifdef MM_HAVE_X86
+/// AVX2 implementations, only called if the CPU supports them.
+namespace avx2 {
+
+__attribute__((target("avx2")))
+void accumulate_savings(int32_t* out, const int32_t* lat, int32_t dc, int32_t num_req, int n) {
+    const __m256i vdc = _mm256_set1_epi32(dc), vn = _mm256_set1_epi32(num_req);
+    const __m256i neg = _mm256_set1_epi32(-1);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i l = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lat + i));
+        __m256i mask = _mm256_cmpgt_epi32(l, neg);
+        __m256i p = _mm256_and_si256(_mm256_mullo_epi32(vn, _mm256_sub_epi32(vdc, l)), mask);
+        __m256i o = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(out + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_add_epi32(o, p));
+    }
+    scalar::accumulate_savings(out + i, lat + i, dc, num_req, n - i);
+}
+
+__attribute__((target("avx2")))
+void accumulate_savings(int64_t* out, const int32_t* lat, int32_t dc, int32_t num_req, int n) {
+    const __m128i vdc = _mm_set1_epi32(dc), vn = _mm_set1_epi32(num_req);
+    const __m128i neg = _mm_set1_epi32(-1);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lat + i));
+        __m128i mask = _mm_cmpgt_epi32(l, neg);
+        __m128i p = _mm_and_si128(_mm_mullo_epi32(vn, _mm_sub_epi32(vdc, l)), mask);
+        __m256i o = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(out + i));
+        o = _mm256_add_epi64(o, _mm256_cvtepi32_epi64(p));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), o);
+    }
+    scalar::accumulate_savings(out + i, lat + i, dc, num_req, n - i);
+}
+
+__attribute__((target("avx2")))
+void accumulate_positive(int32_t* out, const int32_t* lat, int32_t cur, int32_t num_req, int n) {
+    const __m256i vcur = _mm256_set1_epi32(cur), vn = _mm256_set1_epi32(num_req);
+    const __m256i zero = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i l = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lat + i));
+        __m256i o = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(out + i));
+        __m256i mask = _mm256_cmpgt_epi32(o, zero);
+        __m256i d = _mm256_max_epi32(_mm256_sub_epi32(vcur, l), zero);
+        __m256i p = _mm256_and_si256(_mm256_mullo_epi32(vn, d), mask);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_add_epi32(o, p));
+    }
+    scalar::accumulate_positive(out + i, lat + i, cur, num_req, n - i);
+}
+
+__attribute__((target("avx2")))
+void accumulate_positive(int64_t* out, const int32_t* lat, int32_t cur, int32_t num_req, int n) {
+    const __m128i vcur = _mm_set1_epi32(cur), vn = _mm_set1_epi32(num_req);
+    const __m128i zero = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lat + i));
+        __m256i o = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(out + i));
+        __m256i mask = _mm256_cmpgt_epi64(o, _mm256_setzero_si256());
+        __m128i d = _mm_max_epi32(_mm_sub_epi32(vcur, l), zero);
+        __m256i p = _mm256_cvtepi32_epi64(_mm_mullo_epi32(vn, d));
+        o = _mm256_add_epi64(o, _mm256_and_si256(p, mask));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), o);
+    }
+    scalar::accumulate_positive(out + i, lat + i, cur, num_req, n - i);
+}
+
+__attribute__((target("avx2")))
+int32_t max_value(const int32_t* a, int n) {
+    __m256i m = _mm256_set1_epi32(std::numeric_limits<int32_t>::min());
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        m = _mm256_max_epi32(m, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)));
+    }
+    alignas(32) int32_t lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), m);
+    int32_t best = lanes[0];
+    for (int k = 1; k < 8; ++k) best = std::max(best, lanes[k]);
+    for (; i < n; ++i) best = std::max(best, a[i]);
+    return best;
+}
+
+__attribute__((target("avx2")))
+int64_t max_value(const int64_t* a, int n) {
+    __m256i m = _mm256_set1_epi64x(std::numeric_limits<int64_t>::min());
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        m = _mm256_blendv_epi8(m, x, _mm256_cmpgt_epi64(x, m));
+    }
+    alignas(32) int64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), m);
+    int64_t best = lanes[0];
+    for (int k = 1; k < 4; ++k) best = std::max(best, lanes[k]);
+    for (; i < n; ++i) best = std::max(best, a[i]);
+    return best;
+}
+
+/// Bitmask of lanes in a[i .. i+7] equal to v.
+__attribute__((target("avx2")))
+int equal_mask(const int32_t* a, int i, int32_t v) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    __m256i eq = _mm256_cmpeq_epi32(x, _mm256_set1_epi32(v));
+    return _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+}
+
+/// Bitmask of lanes in a[i .. i+3] equal to v.
+__attribute__((target("avx2")))
+int equal_mask(const int64_t* a, int i, int64_t v) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    __m256i eq = _mm256_cmpeq_epi64(x, _mm256_set1_epi64x(v));
+    return _mm256_movemask_pd(_mm256_castsi256_pd(eq));
+}
+
+template <typename save_t>
+int argmax_first(const save_t* a, int n) {
+    if (n <= 0) return -1;
+    const int lanes = 32 / sizeof(save_t);
+    save_t best = max_value(a, n);
+    int i = 0;
+    for (; i + lanes <= n; i += lanes) {
+        int mask = equal_mask(a, i, best);
+        if (mask) return i + __builtin_ctz(mask);
+    }
+    for (; i < n; ++i) {
+        if (a[i] == best) return i;
+    }
+    return -1;
+}
+
+template <typename save_t>
+int argmax_last(const save_t* a, int n) {
+    if (n <= 0) return -1;
+    const int lanes = 32 / sizeof(save_t);
+    save_t best = max_value(a, n);
+    int full = n - n % lanes;
+    for (int i = n - 1; i >= full; --i) {
+        if (a[i] == best) return i;
+    }
+    for (int i = full - lanes; i >= 0; i -= lanes) {
+        int mask = equal_mask(a, i, best);
+        if (mask) return i + 31 - __builtin_clz(mask);
+    }
+    return -1;
+}
+
+}  // namespace avx2
+#endif  // MM_HAVE_X86
+
+bool detect_avx2() {
+    if (std::getenv("HASHCODE_SCALAR") != nullptr) return false;
+#ifdef MM_HAVE_X86
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+}  // namespace
+
+bool has_avx2() {
+    static const bool avx2 = detect_avx2();
+    return avx2;
+}
+
+#ifdef MM_HAVE_X86
+#define MM_SIMD_DISPATCH(name, ...) \
+    if (has_avx2()) return avx2::name(__VA_ARGS__); \
+    return scalar::name(__VA_ARGS__);
+#else
+#define MM_SIMD_DISPATCH(name, ...) return scalar::name(__VA_ARGS__);
+#endif
+
+void accumulate_savings(int32_t* out, const int32_t* lat, int32_t dc, int32_t num_req, int n) {
+    MM_SIMD_DISPATCH(accumulate_savings, out, lat, dc, num_req, n)
+}
+void accumulate_savings(int64_t* out, const int32_t* lat, int32_t dc, int32_t num_req, int n) {
+    MM_SIMD_DISPATCH(accumulate_savings, out, lat, dc, num_req, n)
+}
+void accumulate_positive(int32_t* out, const int32_t* lat, int32_t cur, int32_t num_req, int n) {
+    MM_SIMD_DISPATCH(accumulate_positive, out, lat, cur, num_req, n)
+}
+void accumulate_positive(int64_t* out, const int32_t* lat, int32_t cur, int32_t num_req, int n) {
+    MM_SIMD_DISPATCH(accumulate_positive, out, lat, cur, num_req, n)
+}
+int argmax_first(const int32_t* a, int n) { MM_SIMD_DISPATCH(argmax_first, a, n) }
+int argmax_first(const int64_t* a, int n) { MM_SIMD_DISPATCH(argmax_first, a, n) }
+int argmax_last(const int32_t* a, int n) { MM_SIMD_DISPATCH(argmax_last, a, n) }
+int argmax_last(const int64_t* a, int n) { MM_SIMD_DISPATCH(argmax_last, a, n) }
+
+#undef MM_SIMD_DISPATCH
+
+}  // namespace simd
+}  // namespace mm
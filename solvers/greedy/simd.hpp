@@ -0,0 +1,46 @@
+#ifndef SRC_SIMD_HPP_
+#define SRC_SIMD_HPP_
+
+/**
+ * @file
+ * @brief Vectorised kernels for accumulation and argmax over contiguous rows of savings.
+ * Every kernel has an AVX2 and a scalar implementation. The AVX2 one is chosen at runtime if
+ * the CPU supports it and the environment variable `HASHCODE_SCALAR` is not set.
+ *
+ * Products `num_req * latency` are computed in 32 bit, which holds for the problem limits
+ * (at most 10000 requests per line and latencies of at most 4000 ms) and for the merged
+ * requests of compress_endpoints().
+ */
+
+#include "includes.hpp"
+
+namespace mm {
+namespace simd {
+
+/// True if AVX2 kernels are used.
+bool has_avx2();
+
+/// `out[i] += num_req * (dc - lat[i])` for all `i` with `lat[i] >= 0`.
+void accumulate_savings(int32_t* out, const int32_t* lat, int32_t dc, int32_t num_req, int n);
+/// `out[i] += num_req * (dc - lat[i])` for all `i` with `lat[i] >= 0`.
+void accumulate_savings(int64_t* out, const int32_t* lat, int32_t dc, int32_t num_req, int n);
+
+/// `out[i] += num_req * max(0, cur - lat[i])` for all `i` with `out[i] > 0`.
+void accumulate_positive(int32_t* out, const int32_t* lat, int32_t cur, int32_t num_req, int n);
+/// `out[i] += num_req * max(0, cur - lat[i])` for all `i` with `out[i] > 0`.
+void accumulate_positive(int64_t* out, const int32_t* lat, int32_t cur, int32_t num_req, int n);
+
+/// Index of the first maximal element, -1 if `n == 0`.
+int argmax_first(const int32_t* a, int n);
+/// Index of the first maximal element, -1 if `n == 0`.
+int argmax_first(const int64_t* a, int n);
+
+/// Index of the last maximal element, -1 if `n == 0`.
+int argmax_last(const int32_t* a, int n);
+/// Index of the last maximal element, -1 if `n == 0`.
+int argmax_last(const int64_t* a, int n);
+
+}  // namespace simd
+}  // namespace mm
+
+#endif  // SRC_SIMD_HPP_
@@ -0,0 +1,80 @@
+/**
+ * @file
+ * @brief Checks of reading and validating solutions: read_solution() accepts what the official
+ * scorer accepts and rejects the rest, in particular caches listed more than once.
+ * Usage:
+ *     solution_test
+ * Prints every failed check and exits with 1 if there was any.
+ */
+
+#include <iostream>
+#include <vector>
+#include "includes.hpp"
+#include "instance.hpp"
+#include "score.hpp"
+
+using namespace mm;
+using namespace std;
+
+int failures = 0;
+
+/// Reports a failed check with its source line.
+#define CHECK(cond)                                                                   \
+    do {                                                                              \
+        if (!(cond)) {                                                                \
+            cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #cond << endl;  \
+            ++failures;                                                               \
+        }                                                                             \
+    } while (0)
+
+/// Result of read_solution() on `text` for 3 caches, `error` is set to its error.
+vector<vector<int>> read(const string& text, string& error) {
+    stringstream ss(text);
+    error.clear();
+    return read_solution(ss, 3, &error);
+}
+
+void test_read_solution() {
+    string error;
+    CHECK(read("2\n0 1 2\n2 3\n", error) == vector<vector<int>>({{1, 2}, {}, {3}}));
+    CHECK(error.empty());
+    CHECK(read("0\n", error) == vector<vector<int>>(3));
+    CHECK(error.empty());
+    CHECK(read("1\n1\n", error) == vector<vector<int>>({{}, {}, {}}));
+
+    CHECK(read("2\n0 1\n0 2\n", error).empty());
+    CHECK(error == "cache 0 listed more than once");
+    CHECK(read("3\n1\n2 4\n1 5\n", error).empty());
+    CHECK(error == "cache 1 listed more than once");
+    CHECK(read("4\n", error).empty());
+    CHECK(!error.empty());
+    CHECK(read("1\n3 1\n", error).empty());
+    CHECK(!error.empty());
+    CHECK(read("2\n0 1\n", error).empty());
+    CHECK(!error.empty());
+    CHECK(read("", error).empty());
+    CHECK(!error.empty());
+
+    // the error argument is optional
+    stringstream ss("2\n0 1\n0 2\n");
+    CHECK(read_solution(ss, 3).empty());
+}
+
+void test_check_solution() {
+    stringstream ss("2 1 1 2 10\n6 5\n1000 1\n0 100\n0 0 1\n");
+    Instance inst = read_instance(ss);
+    CHECK(check_solution(inst, {{1}, {0}}).empty());
+    CHECK(!check_solution(inst, {{0, 1}, {}}).empty());  // 11 MB in a 10 MB cache
+    CHECK(!check_solution(inst, {{2}, {}}).empty());  // no video 2
+}
+
+int main() {
+    test_read_solution();
+    test_check_solution();
+    if (failures) {
+        cerr << failures << " checks failed." << endl;
+        return 1;
+    }
+    cerr << "All checks passed." << endl;
+    return 0;
+}
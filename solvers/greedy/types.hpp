@@ -10,13 +10,15 @@
  * @example types_test.cpp
  */
 
-#include "includes.hpp"
-#include "common.hpp"
-
+// Eigen must come before includes.hpp, whose never_use math overloads make its unqualified
+// calls ambiguous. Include this header before any other header of the project.
 /// @cond
 #include "Eigen/Dense"
 /// @endcond
 
+#include "includes.hpp"
+#include "common.hpp"
+
 namespace Eigen {
 /**
  * Return iterator pointing to the begining of matrix.
@@ -310,7 +312,7 @@ class VecX : public Eigen::Matrix<Scalar, Eigen::Dynamic, 1> {
             assert(0 <= idx && idx < size() &&
                    "One of indexes out of range when using multi-indexed read access.");
         VecX res(indexes.size());
-        for (int idx : indexes) res[idx] = operator[](idx);
+        for (size_t i = 0; i < indexes.size(); ++i) res[i] = operator[](indexes[i]);
         return res;
     }
 
@@ -429,7 +431,7 @@ typedef VecX<double> VecXd;
  * @brief extension of std::vector with additional access operators
  * This is a general container, for example for Vec2d. For numeric values
  * and operators use VecXd.
- * @details see test_types.cpp for examples
+ * @details see types_test.cpp for examples
  * @tparam T type of data inside of class
  */
 template <class T>
@@ -564,6 +566,53 @@ class Range : public std::vector<T> {
             return filter([&](const value_type& t) { return t != v; });
         }
     };
+
+    /**
+     * Read only view of elements at a list of indexes. Unlike RangeView and the multi-indexed
+     * read access it does not check indexes and never allocates, so it is meant for hot loops
+     * over indexes that are known to be valid, e.g., ones returned by filter().
+     */
+    class IndexView {
+      public:
+        /// Iterator over viewed elements.
+        class const_iterator {
+          public:
+            /// Iterator at the `pos`-th index.
+            const_iterator(const Range<T>& receiver, indexes_t::const_iterator pos)
+                    : receiver_(&receiver), pos_(pos) {}
+            /// Viewed element.
+            const_reference operator*() const {
+                return receiver_->std::vector<T>::operator[](*pos_);
+            }
+            /// Move to next index.
+            const_iterator& operator++() { ++pos_; return *this; }
+            /// True if iterators point to different indexes.
+            bool operator!=(const const_iterator& other) const { return pos_ != other.pos_; }
+
+          private:
+            const Range<T>* receiver_;
+            indexes_t::const_iterator pos_;
+        };
+
+        /// View of `receiver` at `indexes`, both must outlive the view.
+        IndexView(const Range<T>& receiver, const indexes_t& indexes)
+                : receiver_(receiver), indexes_(indexes) {}
+        /// Element at the `i`-th index, unchecked.
+        const_reference operator[](size_type i) const {
+            return receiver_.std::vector<T>::operator[](indexes_[i]);
+        }
+        /// Number of viewed elements.
+        size_type size() const { return indexes_.size(); }
+        /// Iterator to first viewed element
+        const_iterator begin() const { return {receiver_, indexes_.begin()}; }
+        /// Iterator past last viewed element
+        const_iterator end() const { return {receiver_, indexes_.end()}; }
+
+      private:
+        const Range<T>& receiver_;
+        const indexes_t& indexes_;
+    };
+
   public:
     /// Default constructor
     Range<T>() {}
@@ -667,6 +716,19 @@ class Range : public std::vector<T> {
             if (pred(operator[](i))) ret.push_back(i);
         return ret;
     }
+    /**
+     * Same as filter(), but writes indexes into `out`, replacing its contents. Reusing `out`
+     * between calls avoids allocations once it is large enough.
+     */
+    template <class Pred>
+    void filter_into(const Pred& pred, indexes_t& out) const {
+        out.clear();
+        size_type n = size();
+        for (size_type i = 0; i < n; ++i)
+            if (pred(std::vector<T>::operator[](i))) out.push_back(i);
+    }
+    /// Unchecked, non allocating read only view of elements at `indexes`, see IndexView.
+    IndexView view(const indexes_t& indexes) const { return {*this, indexes}; }
     /// Returns list of indexes for which their elements compare less than a
     indexes_t operator<(const value_type& v) const {
         return filter([&](const value_type& t) { return t < v; });
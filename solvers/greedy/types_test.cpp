@@ -0,0 +1,169 @@
+/**
+ * @file
+ * @brief Checks of Range, its views and VecX multi-indexed access. Fixed examples document the
+ * behaviour, randomized ones compare every access path against plain std::vector loops.
+ * Usage:
+ *     types_test [--rounds N] [--seed S]
+ * The seed defaults to 1, so failures are reproducible. Prints every failed check and exits
+ * with 1 if there was any.
+ */
+
+#include "types.hpp"
+#include "driver.hpp"
+
+using namespace mm;
+using namespace std;
+
+int failures = 0;
+
+/// Reports a failed check with its source line.
+#define CHECK(cond)                                                                   \
+    do {                                                                              \
+        if (!(cond)) {                                                                \
+            cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #cond << endl;  \
+            ++failures;                                                               \
+        }                                                                             \
+    } while (0)
+
+/// Reads all elements of an IndexView through its iterators.
+template <typename T>
+vector<T> collect(const typename Range<T>::IndexView& view) {
+    vector<T> out;
+    for (const T& x : view) out.push_back(x);
+    return out;
+}
+
+void test_range() {
+    Range<int> a = {5, 1, 4, 1, 3};
+    CHECK(a.size() == 5);
+    CHECK(a[2] == 4);
+    CHECK((a < 4) == indexes_t({1, 3, 4}));
+    CHECK((a >= 4) == indexes_t({0, 2}));
+    CHECK((a == 1) == indexes_t({1, 3}));
+    CHECK((a != 1) == indexes_t({0, 2, 4}));
+    CHECK(a.join(Range<int>({7})) == Range<int>({5, 1, 4, 1, 3, 7}));
+
+    Range<int> b = a;
+    b.append({7, 8});
+    CHECK(b == Range<int>({5, 1, 4, 1, 3, 7, 8}));
+    b = 2;
+    CHECK(b == Range<int>(7, 2));
+}
+
+void test_range_view() {
+    Range<int> a = {5, 1, 4, 1, 3};
+    indexes_t idx = {0, 2, 4};
+    CHECK(a[idx] == Range<int>({5, 4, 3}));
+    a[idx] = 0;
+    CHECK(a == Range<int>({0, 1, 0, 1, 0}));
+    a[idx] = {7, 8, 9};
+    CHECK(a == Range<int>({7, 1, 8, 1, 9}));
+    a[idx] = Range<int>({1, 2, 3});
+    CHECK(a == Range<int>({1, 1, 2, 1, 3}));
+    CHECK(a[idx].size() == 3);
+    CHECK((a[idx] == 2) == indexes_t({1}));
+    indexes_t ones = a == 1;
+    CHECK(a[ones] == Range<int>(3, 1));
+    CHECK(a[idx] != Range<int>({1, 2}));
+}
+
+void test_const_reads() {
+    const Range<int> a = {5, 1, 4, 1, 3};
+    indexes_t idx = {4, 0, 4};
+    CHECK(a[idx] == Range<int>({3, 5, 3}));
+    CHECK(a[indexes_t()].empty());
+
+    const VecX<double> v = {0.5, 1.5, 2.5};
+    VecX<double> read = v[indexes_t({2, 0})];
+    CHECK(read.size() == 2 && read[0] == 2.5 && read[1] == 0.5);
+    CHECK(v[indexes_t()].size() == 0);
+
+    VecX<double> w = v;
+    w[indexes_t({1})] = 9.0;
+    CHECK(w[1] == 9.0 && w[0] == 0.5);
+}
+
+void test_filter_and_view() {
+    const Range<int> a = {5, 1, 4, 1, 3};
+    auto odd = [](int x) { return x % 2 != 0; };
+    indexes_t out = {42};
+    a.filter_into(odd, out);
+    CHECK(out == a.filter(odd));
+    CHECK(out == indexes_t({0, 1, 3, 4}));
+    a.filter_into([](int) { return false; }, out);
+    CHECK(out.empty());
+
+    indexes_t idx = {3, 0};
+    Range<int>::IndexView view = a.view(idx);
+    CHECK(view.size() == 2);
+    CHECK(view[0] == 1 && view[1] == 5);
+    CHECK(collect<int>(view) == vector<int>({1, 5}));
+    CHECK(collect<int>(a.view(indexes_t())).empty());
+}
+
+/// Compares every access path with plain loops on random ranges and thresholds.
+void test_random(int rounds, unsigned seed) {
+    mt19937 rng(seed);
+    for (int r = 0; r < rounds; ++r) {
+        int n = uniform_int_distribution<int>(0, 200)(rng);
+        uniform_int_distribution<int> value(-50, 50);
+        vector<int> raw(n);
+        for (int& x : raw) x = value(rng);
+        const Range<int> a(raw);
+        int threshold = value(rng);
+        auto pred = [threshold](int x) { return x < threshold; };
+
+        indexes_t expected;
+        for (int i = 0; i < n; ++i) {
+            if (raw[i] < threshold) expected.push_back(i);
+        }
+        CHECK(a.filter(pred) == expected);
+        CHECK((a < threshold) == expected);
+        indexes_t out;
+        a.filter_into(pred, out);
+        CHECK(out == expected);
+
+        // random indexes, with repeats and in any order
+        indexes_t idx(uniform_int_distribution<int>(0, 2 * n)(rng));
+        if (n == 0) idx.clear();
+        for (int& i : idx) i = uniform_int_distribution<int>(0, n - 1)(rng);
+        vector<int> gathered;
+        for (int i : idx) gathered.push_back(raw[i]);
+        CHECK(a[idx] == Range<int>(gathered));
+        CHECK(a.view(idx).size() == static_cast<int>(idx.size()));
+        CHECK(collect<int>(a.view(idx)) == gathered);
+        bool same = true;
+        for (size_t k = 0; k < idx.size(); ++k) same = same && a.view(idx)[k] == gathered[k];
+        CHECK(same);
+
+        VecX<double> v(n);
+        for (int i = 0; i < n; ++i) v[i] = raw[i];
+        const VecX<double>& cv = v;
+        VecX<double> read = cv[idx];
+        same = read.size() == static_cast<int>(idx.size());
+        for (size_t k = 0; same && k < idx.size(); ++k) same = read[k] == gathered[k];
+        CHECK(same);
+
+        // writing through a view touches exactly the viewed elements
+        Range<int> b(raw);
+        indexes_t sel = a.filter(pred);
+        b[sel] = threshold;
+        for (int i = 0; i < n; ++i) CHECK(b[i] == (raw[i] < threshold ? threshold : raw[i]));
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Options opt(argc, argv);
+    unsigned int seed = opt.has("seed") ? opt.seed() : 1;
+    test_range();
+    test_range_view();
+    test_const_reads();
+    test_filter_and_view();
+    test_random(opt.get_int("rounds", 1000), seed);
+    if (failures) {
+        cerr << failures << " checks failed, rerun with --seed " << seed << "." << endl;
+        return 1;
+    }
+    cerr << "All checks passed." << endl;
+    return 0;
+}